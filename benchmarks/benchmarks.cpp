@@ -0,0 +1,414 @@
+/**
+ * Бенчмарки горячих функций: коллизии, генератор случайных чисел, разбор .obj и загрузка уровня. Окно и контекст OpenGL не создаются,
+ * шейдеры пустые, как в режиме --headless. Запускается из корня репозитория, так как читает resources/.
+ *
+ * Использование: benchmarks [--filter <подстрока>] [--baseline <файл>]
+ *
+ * Результаты выводятся в stdout в формате TSV, по строке на бенчмарк, в постоянном порядке:
+ *   name  iterations  median_ns  min_ns  allocs
+ * где median_ns и min_ns - медиана и минимум времени одной операции по SAMPLES замерам,
+ * allocs - выделений памяти в куче за одну операцию.
+ * С --baseline к каждой строке добавляются baseline_ns (median_ns из файла) и change (изменение медианы),
+ * поэтому результат до оптимизации можно сохранить в файл и сравнить с ним результат после
+ */
+
+#include "main/shaders.h"
+#include "level/level.h"
+#include "entity/player.h"
+#include "entity/enemy.h"
+#include "entity/bullet.h"
+#include "model/obj_loader.h"
+#include "memory/alloc_counter.h"
+#include "util.h"
+#include "random.h"
+#include "dir_paths.h"
+
+#include <map>
+#include <random>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+
+namespace hack_game {
+	using std::string;
+	using std::vector;
+
+	using glm::vec2;
+	using glm::vec3;
+
+	using clock = std::chrono::steady_clock;
+	using Nanoseconds = std::chrono::duration<double, std::nano>;
+
+	static constexpr int SAMPLES = 15;
+	static constexpr clock::duration MIN_SAMPLE_TIME = std::chrono::milliseconds(10);
+	static constexpr size_t INPUT_COUNT = 1024; // Входные данные перебираются по кругу, чтобы компилятор не свернул вызов
+	static constexpr unsigned SEED = 1;
+
+	static const char* const LEVEL_PATH = LEVELS_DIR "level1.json";
+
+
+	/// @brief Не даёт компилятору выбросить вычисление value
+	template<typename T>
+	static void doNotOptimize(const T& value) {
+		asm volatile("" : : "r,m"(value) : "memory");
+	}
+
+
+	struct Result {
+		string name;
+		uint64_t iterations;
+		double medianNs, minNs, allocs;
+	};
+
+	struct Options {
+		string filter;
+		std::map<string, double> baseline; // name -> median_ns
+	};
+
+
+	/**
+	 * @brief Замеряет operation. Количество итераций в замере подбирается так, чтобы замер длился
+	 * не меньше MIN_SAMPLE_TIME, затем делается SAMPLES замеров
+	 */
+	template<typename Operation>
+	static Result measure(const string& name, Operation&& operation) {
+		uint64_t iterations = 1;
+
+		for (;;) {
+			const clock::time_point start = clock::now();
+
+			for (uint64_t i = 0; i < iterations; i++) {
+				operation();
+			}
+
+			if (clock::now() - start >= MIN_SAMPLE_TIME) {
+				break;
+			}
+
+			iterations *= 2;
+		}
+
+		double samples[SAMPLES];
+		const size_t allocationsBefore = getThreadHeapAllocationCount();
+
+		for (double& sample : samples) {
+			const clock::time_point start = clock::now();
+
+			for (uint64_t i = 0; i < iterations; i++) {
+				operation();
+			}
+
+			sample = Nanoseconds(clock::now() - start).count() / double(iterations);
+		}
+
+		const double allocs = double(getThreadHeapAllocationCount() - allocationsBefore) / double(iterations * SAMPLES);
+
+		std::sort(std::begin(samples), std::end(samples));
+		return Result { name, iterations, samples[SAMPLES / 2], samples[0], allocs };
+	}
+
+
+	class Benchmarks {
+		const Options& options;
+		ShaderManager shaderManager = createShaderManager(0, 0, true);
+		std::mt19937 random { SEED };
+
+	public:
+		explicit Benchmarks(const Options& options):
+				options(options) {
+
+			std::cout << "name\titerations\tmedian_ns\tmin_ns\tallocs";
+
+			if (!options.baseline.empty()) {
+				std::cout << "\tbaseline_ns\tchange";
+			}
+
+			std::cout << '\n';
+		}
+
+		template<typename Operation>
+		void run(const string& name, Operation&& operation) {
+			if (name.find(options.filter) == string::npos) {
+				return;
+			}
+
+			print(measure(name, std::forward<Operation>(operation)));
+		}
+
+		float uniform(float low, float high) {
+			return std::uniform_real_distribution<float>(low, high)(random);
+		}
+
+		vec2 uniformVec2(float low, float high) {
+			return vec2(uniform(low, high), uniform(low, high));
+		}
+
+		ShaderManager& getShaderManager() noexcept {
+			return shaderManager;
+		}
+
+	private:
+		void print(const Result& result) {
+			std::cout << result.name << '\t' << result.iterations << '\t'
+			          << std::fixed << std::setprecision(1) << result.medianNs << '\t' << result.minNs << '\t'
+			          << std::setprecision(2) << result.allocs;
+
+			if (!options.baseline.empty()) {
+				const auto it = options.baseline.find(result.name);
+
+				if (it != options.baseline.end()) {
+					std::cout << '\t' << std::setprecision(1) << it->second << '\t'
+					          << std::showpos << (result.medianNs / it->second - 1.0) * 100.0 << '%' << std::noshowpos;
+				} else {
+					std::cout << "\t-\t-";
+				}
+			}
+
+			std::cout << std::endl;
+		}
+	};
+
+
+	// ------------------------------------------ collisions -------------------------------------------
+
+	struct Segment {
+		vec2 pos, offset, center;
+	};
+
+	static void benchmarkIntersectPoint(Benchmarks& benchmarks) {
+		static constexpr float RADIUS = 1.0f;
+
+		vector<Segment> hits, misses, verticals;
+
+		for (size_t i = 0; i < INPUT_COUNT; i++) {
+			// Отрезок из точки снаружи окружности к её центру всегда пересекает окружность
+			const vec2 center = benchmarks.uniformVec2(-10, 10);
+			const vec2 pos = center + glm::normalize(benchmarks.uniformVec2(-1, 1) + vec2(EPSILON)) * (RADIUS * 2);
+			hits.push_back(Segment { pos, center - pos, center });
+
+			// Отрезок, который целиком лежит далеко от окружности
+			misses.push_back(Segment { center + vec2(RADIUS * 3), benchmarks.uniformVec2(0, 1), center });
+
+			verticals.push_back(Segment { center + vec2(benchmarks.uniform(-RADIUS, RADIUS), RADIUS * 2), vec2(0, -RADIUS * 2), center });
+		}
+
+		const auto run = [&benchmarks] (const string& name, const vector<Segment>& segments) {
+			size_t i = 0;
+
+			benchmarks.run(name, [&] () {
+				const Segment& segment = segments[i++ % segments.size()];
+				doNotOptimize(getIntersectPoint(segment.pos, segment.offset, segment.center, RADIUS));
+			});
+		};
+
+		run("getIntersectPoint/hit", hits);
+		run("getIntersectPoint/miss", misses);
+		run("getIntersectPoint/vertical", verticals);
+	}
+
+
+	struct Move {
+		vec2 pos, offset;
+	};
+
+	static void benchmarkEnemyCollision(Benchmarks& benchmarks, const Level& level) {
+		const vec3 enemyPos = level.getEnemy()->getPos();
+		const vec2 center(enemyPos.x, enemyPos.z);
+
+		// Игрок движется к врагу с расстояния, на котором столкновение возможно
+		vector<Move> moves;
+
+		for (size_t i = 0; i < INPUT_COUNT; i++) {
+			const vec2 direction = glm::normalize(benchmarks.uniformVec2(-1, 1) + vec2(EPSILON));
+			const vec2 pos = center + direction * (Enemy::RADIUS * 2);
+			moves.push_back(Move { pos, -direction * (Enemy::RADIUS * 1.5f) });
+		}
+
+		size_t i = 0;
+
+		benchmarks.run("resolveEnemyCollision", [&] () {
+			const Move& move = moves[i++ % moves.size()];
+			doNotOptimize(resolveEnemyCollision(level, move.pos, move.offset));
+		});
+	}
+
+
+	static void benchmarkBlockCollision(Benchmarks& benchmarks, const Level& level) {
+		const float width = level.map.width() * TILE_SIZE;
+		const float height = level.map.height() * TILE_SIZE;
+
+		// Смещения не больше клетки, как за один тик
+		vector<Move> moves;
+
+		for (size_t i = 0; i < INPUT_COUNT; i++) {
+			const vec2 pos(benchmarks.uniform(0, width), benchmarks.uniform(0, height));
+			moves.push_back(Move { pos, benchmarks.uniformVec2(-TILE_SIZE, TILE_SIZE) });
+		}
+
+		size_t i = 0;
+
+		benchmarks.run("resolveBlockCollision", [&] () {
+			const Move& move = moves[i++ % moves.size()];
+			doNotOptimize(resolveBlockCollision(level, move.pos, move.offset));
+		});
+	}
+
+
+	/// Открывает PlayerBullet::checkCollision для замера
+	class BenchmarkBullet: public PlayerBullet {
+	public:
+		using PlayerBullet::PlayerBullet;
+		using PlayerBullet::checkCollision;
+	};
+
+	/// @brief Замеряет проверку коллизии снаряда игрока, рядом с которым count снарядов врага. Снаряд ни с кем не сталкивается
+	static void benchmarkBulletCollision(Benchmarks& benchmarks, size_t count) {
+		Level level(benchmarks.getShaderManager(), LEVEL_PATH);
+		Shader& shader = benchmarks.getShaderManager().getShader("lightInstanced");
+
+		const vec3 pos = level.getPlayer()->getPos();
+
+		// Снаряды врага лежат в соседних клетках сетки, но дальше своего радиуса от снаряда игрока
+		for (size_t i = 0; i < count; i++) {
+			const vec2 direction = glm::normalize(benchmarks.uniformVec2(-1, 1) + vec2(EPSILON));
+			const vec2 offset = direction * benchmarks.uniform(Enemy::RADIUS * 1.25f, TILE_SIZE);
+			level.addEntity(std::make_shared<EnemyBullet>(shader, false, vec3(0), pos + vec3(offset.x, 0, offset.y)));
+		}
+
+		level.updateEntities();
+
+		const std::shared_ptr<BenchmarkBullet> bullet = std::make_shared<BenchmarkBullet>(shader, 0.0f, vec3(0), pos);
+
+		benchmarks.run("PlayerBullet::checkCollision/" + std::to_string(count), [&] () {
+			doNotOptimize(bullet->checkCollision(level));
+		});
+	}
+
+
+	// -------------------------------------------- random --------------------------------------------
+
+	static void benchmarkRandom(Benchmarks& benchmarks) {
+		static constexpr size_t BATCH_SIZE = 64; // Примерно столько частиц создаёт одна анимация
+
+		Random random(SEED);
+		vec3 batch[BATCH_SIZE];
+
+		benchmarks.run("Random::nextFloat", [&] () {
+			doNotOptimize(random.nextFloat(-1.0f, 1.0f));
+		});
+
+		benchmarks.run("Random::nextVec3", [&] () {
+			doNotOptimize(random.nextVec3(vec3(-1.0f), vec3(1.0f)));
+		});
+
+		benchmarks.run("Random::fillVec3s/" + std::to_string(BATCH_SIZE), [&] () {
+			random.fillVec3s(batch, BATCH_SIZE, vec3(-1.0f), vec3(1.0f));
+			doNotOptimize(batch[BATCH_SIZE - 1]);
+		});
+	}
+
+
+	// ------------------------------------------- loading --------------------------------------------
+
+	static void benchmarkObjLoader(Benchmarks& benchmarks, const char* file, uint32_t flags) {
+		const string path = string(MODELS_DIR) + file;
+
+		benchmarks.run(string("obj_loader::load/") + file, [&] () {
+			doNotOptimize(obj_loader::load(path, flags).vertices.size());
+		});
+	}
+
+
+	static void benchmarkLevel(Benchmarks& benchmarks, const char* file) {
+		const string path = string(LEVELS_DIR) + file;
+
+		benchmarks.run(string("Level/") + file, [&] () {
+			Level level(benchmarks.getShaderManager(), path);
+			doNotOptimize(level.getPlayer().get());
+		});
+	}
+
+
+	static void runAll(Benchmarks& benchmarks) {
+		benchmarkIntersectPoint(benchmarks);
+
+		{
+			Level level(benchmarks.getShaderManager(), LEVEL_PATH);
+			benchmarkEnemyCollision(benchmarks, level);
+			benchmarkBlockCollision(benchmarks, level);
+		}
+
+		for (size_t count : {0, 8, 64, 512}) {
+			benchmarkBulletCollision(benchmarks, count);
+		}
+
+		benchmarkRandom(benchmarks);
+
+		// Те же флаги, что у ColoredModel, FrameModel и TexturedModel
+		benchmarkObjLoader(benchmarks, "sphere.obj",        obj_loader::NORMALS | obj_loader::TRIANGULATE);
+		benchmarkObjLoader(benchmarks, "player/center.obj", obj_loader::NORMALS | obj_loader::TRIANGULATE);
+		benchmarkObjLoader(benchmarks, "minion.obj",        obj_loader::NORMALS | obj_loader::TRIANGULATE);
+		benchmarkObjLoader(benchmarks, "cube-frame.obj",    0);
+		benchmarkObjLoader(benchmarks, "plane.obj",         obj_loader::TEX_COORDS | obj_loader::TRIANGULATE);
+
+		benchmarkLevel(benchmarks, "level1.json");
+	}
+
+
+	/// @brief Читает median_ns из результатов прошлого запуска
+	static std::map<string, double> readBaseline(const char* path) {
+		std::ifstream file(path);
+
+		if (!file.is_open()) {
+			std::cerr << "Cannot open file '" << path << "'" << std::endl;
+			exit(EXIT_FAILURE);
+		}
+
+		std::map<string, double> baseline;
+		string line;
+		std::getline(file, line); // Заголовок
+
+		while (std::getline(file, line)) {
+			std::istringstream stream(line);
+			string name;
+			uint64_t iterations;
+			double medianNs;
+
+			if (std::getline(stream, name, '\t') && stream >> iterations >> medianNs) {
+				baseline[name] = medianNs;
+			}
+		}
+
+		return baseline;
+	}
+}
+
+
+int main(int argc, const char* argv[]) {
+	using namespace hack_game;
+
+	Options options;
+
+	for (int i = 1; i < argc; i++) {
+		const string arg = argv[i];
+
+		if (arg == "--filter" && i + 1 < argc) {
+			options.filter = argv[++i];
+		} else if (arg == "--baseline" && i + 1 < argc) {
+			options.baseline = readBaseline(argv[++i]);
+		} else {
+			std::cerr << "Usage: " << argv[0] << " [--filter <substring>] [--baseline <results.tsv>]" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	Benchmarks benchmarks(options);
+	runAll(benchmarks);
+	return 0;
+}
@@ -2,8 +2,6 @@
 #include "common.glsl"
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
 
 layout (location = 0) in vec3 position;
 
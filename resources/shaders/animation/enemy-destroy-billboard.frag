@@ -3,9 +3,8 @@
 
 uniform vec3 centerPos;
 uniform float progress;
-uniform sampler2D texture0;
-uniform sampler2D texture1;
-uniform sampler2D texture2;
+uniform sampler2DArray frames;
+uniform int firstFrame;
 
 in vec3 fragPos;
 in vec2 fragTexCoord;
@@ -80,9 +79,9 @@ void drawCircle(float dist, float startTime, float endTime, float minRadius, flo
 }
 
 
-void drawFigure(sampler2D tex, float angleSin, float angleCos) {
+void drawFigure(int frame, float angleSin, float angleCos) {
 	vec2 scaledTexCoord = rotate(fragTexCoord - 0.5, angleSin, angleCos) * 200.0 + 0.5;
-	result = blend(result, texture(tex, scaledTexCoord));
+	result = blend(result, texture(frames, vec3(scaledTexCoord, firstFrame + frame)));
 }
 
 
@@ -107,13 +106,13 @@ void main() {
 	
 	
 	if (progress >= FIG0_START && progress <= FIG0_END) {
-		drawFigure(texture0, SIN_0, COS_0);
+		drawFigure(0, SIN_0, COS_0);
 		
 	} else if (progress >= FIG1_START && progress <= FIG1_END) {
-		drawFigure(texture1, SIN_0, COS_0);
+		drawFigure(1, SIN_0, COS_0);
 		
 	} else if (progress >= FIG2_START && progress <= FIG2_END) {
-		drawFigure(texture2, SIN_45, COS_45);
+		drawFigure(2, SIN_45, COS_45);
 	}
 	
 	
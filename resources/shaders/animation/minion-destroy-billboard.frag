@@ -5,9 +5,8 @@ uniform vec3 centerPos;
 uniform vec3 angleNormal;
 uniform float progress;
 uniform int seed;
-uniform sampler2D texture0;
-uniform sampler2D texture1;
-uniform sampler2D texture2;
+uniform sampler2DArray frames;
+uniform int firstFrame;
 
 in vec3 fragPos;
 in vec2 fragTexCoord;
@@ -94,9 +93,9 @@ void drawLines(float distToCenter) {
 	}
 }
 
-void drawFigure(sampler2D tex, float angleSin, float angleCos) {
+void drawFigure(int frame, float angleSin, float angleCos) {
 	vec2 scaledTexCoord = rotate(fragTexCoord - 0.5, angleSin, angleCos) * 25.0 + 0.5;
-	result = blend(result, texture(tex, scaledTexCoord));
+	result = blend(result, texture(frames, vec3(scaledTexCoord, firstFrame + frame)));
 }
 
 
@@ -108,12 +107,12 @@ void main() {
 	drawLines(distToCenter);
 	
 	if (progress >= FIG0_START && progress <= FIG0_END) {
-		drawFigure(texture0, SIN_45, COS_45);
+		drawFigure(0, SIN_45, COS_45);
 		
 	} else if (progress >= FIG1_START && progress <= FIG1_END) {
-		drawFigure(texture1, SIN_0, COS_0);
+		drawFigure(1, SIN_0, COS_0);
 		
 	} else if (progress >= FIG2_START && progress <= FIG2_END) {
-		drawFigure(texture2, SIN_45, COS_45);
+		drawFigure(2, SIN_45, COS_45);
 	}
 }
@@ -1,8 +1,8 @@
 #version 330 core
 #include "common.glsl"
 
-uniform float alpha;
-uniform uint mode;
+flat in float alpha;
+flat in uint mode;
 
 out vec4 result;
 
@@ -0,0 +1,21 @@
+#version 330 core
+#include "common.glsl"
+
+layout (location = 0) in vec3 position;
+
+// Атрибуты экземпляра (InstanceBuffer)
+layout (location = 2) in mat4 instanceModel;
+layout (location = 6) in vec4 instanceData; // x - прозрачность, y - режим
+
+out vec3 fragPos;
+flat out float alpha;
+flat out uint mode;
+
+void main() {
+	alpha = instanceData.x;
+	mode = uint(instanceData.y);
+
+	vec4 pos = instanceModel * vec4(position, 1.0);
+	fragPos = vec3(pos);
+	gl_Position = projection * view * pos;
+}
@@ -1,3 +1,11 @@
+// Общие данные кадра, одинаковые для всех шейдеров (FrameUniforms в shader/frame_uniforms.h)
+layout (std140) uniform Frame {
+	mat4 view;
+	mat4 projection;
+	vec3 lightPos;
+	vec3 lightColor;
+};
+
 #define GRAY(rgb, alp) vec4(rgb, rgb, rgb, alp)
 
 vec4 blend(vec4 color1, vec4 color2) {
@@ -0,0 +1,11 @@
+#version 330 core
+
+uniform float modelBrightness;
+
+flat in vec3 modelColor;
+
+out vec4 color;
+
+void main() {
+	color = vec4(modelColor * modelBrightness, 1.0f);
+}
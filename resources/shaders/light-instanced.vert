@@ -0,0 +1,16 @@
+#version 330 core
+#include "common.glsl"
+
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 normal;
+
+// Атрибуты экземпляра (InstanceBuffer)
+layout (location = 2) in mat4 instanceModel;
+layout (location = 6) in vec4 instanceData; // rgb - цвет
+
+flat out vec3 modelColor;
+
+void main() {
+	modelColor = instanceData.rgb;
+	gl_Position = projection * view * instanceModel * vec4(position, 1.0);
+}
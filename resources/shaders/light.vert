@@ -1,8 +1,7 @@
 #version 330 core
+#include "common.glsl"
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
 
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec3 normal;
@@ -1,7 +1,6 @@
 #version 330 core
+#include "common.glsl"
 
-uniform vec3 lightColor;
-uniform vec3 lightPos;
 uniform vec3 modelColor;
 uniform float modelBrightness;
 
@@ -2,19 +2,41 @@
 import matplotlib.pyplot as plt
 
 # Чтение данных из файла в формате:
-# возвращает dict: {shader_id: [время_покадрово]}
+# frame
+# <id шейдера> <время в наносекундах>
+# ...
+# dropped  - кадр, результаты которого видеокарта не успела выдать
+# возвращает dict: {shader_id: [время_покадрово]}, где None - шейдер не выполнялся в кадре или кадр отброшен.
+# Списки всех шейдеров имеют одну длину, поэтому кадры разных запусков сравниваются по номеру.
+# В старых файлах нет строк frame и dropped, тогда время каждого шейдера просто идёт подряд
 def read_times_per_frame(filename):
-	times = {}
+	frames = []
+	legacy = {}
 	with open(filename, 'r') as f:
 		for line in f:
 			parts = line.strip().split()
-			if len(parts) != 2:
-				continue
-			shader_id, time = int(parts[0]), int(parts[1])
-			if shader_id not in times:
-				times[shader_id] = []
-			times[shader_id].append(time)
-	return times
+			if parts == ['frame']:
+				frames.append({})
+			elif parts == ['dropped']:
+				frames.append(None)
+			elif len(parts) == 2:
+				shader_id, time = int(parts[0]), int(parts[1])
+				if frames:
+					if frames[-1] is not None:
+						frames[-1][shader_id] = time
+				else:
+					legacy.setdefault(shader_id, []).append(time)
+
+	if not frames:
+		return legacy
+
+	shader_ids = set()
+	for frame in frames:
+		if frame is not None:
+			shader_ids |= frame.keys()
+
+	return {shader_id: [frame.get(shader_id) if frame is not None else None for frame in frames]
+			for shader_id in shader_ids}
 
 old_times = read_times_per_frame('debug/shaders-time.log.old')
 new_times = read_times_per_frame('debug/shaders-time.log')
@@ -37,17 +59,24 @@ for axis, shader_id in zip(axes, shader_ids):
 	
 	frames = list(range(1, max_frames+1))
 	
-	old_padded = old + [0]*(max_frames - len(old))
-	new_padded = new + [0]*(max_frames - len(new))
+	old_padded = old + [None]*(max_frames - len(old))
+	new_padded = new + [None]*(max_frames - len(new))
 	
-	axis.plot(frames, old_padded, color='gray', label='старое')
+	# Пропуски (None) не отрисовываются
+	axis.plot(frames, [float('nan') if o is None else o for o in old_padded], color='gray', label='старое')
 	
+	new_frames = []
+	new_values = []
 	colors = []
-	for o, n in zip(old_padded, new_padded):
-		d = o - n
+	for frame, o, n in zip(frames, old_padded, new_padded):
+		if n is None:
+			continue
+		new_frames.append(frame)
+		new_values.append(n)
+		d = 0 if o is None else o - n
 		colors.append('orange' if abs(d) <= 1e5 else 'green' if d >= 0 else 'red')
 	
-	axis.scatter(frames, new_padded, color=colors, label='новое')
+	axis.scatter(new_frames, new_values, color=colors, label='новое')
 	
 	axis.set_ylabel(f'Шейдер {shader_id}')
 	axis.legend(loc='upper right')
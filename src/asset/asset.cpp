@@ -0,0 +1,10 @@
+#include "asset.h"
+
+namespace hack_game {
+
+	std::vector<Asset*> Asset::manifest;
+
+	Asset::Asset() {
+		manifest.push_back(this);
+	}
+}
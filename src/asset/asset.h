@@ -0,0 +1,42 @@
+#ifndef HACK_GAME__ASSET__ASSET_H
+#define HACK_GAME__ASSET__ASSET_H
+
+#include <string>
+#include <vector>
+
+namespace hack_game {
+
+	/**
+	 * @brief Ресурс, который читается с диска на этапе загрузки ресурсов (см. AssetLoader).
+	 * Каждый ресурс при создании добавляется в манифест, поэтому ресурсы можно объявлять вместе с моделями.
+	 * Сам конструктор файлы не открывает
+	 */
+	class Asset {
+		static std::vector<Asset*> manifest;
+
+	public:
+		/// @return Все созданные ресурсы в порядке создания
+		static const std::vector<Asset*>& getManifest() noexcept {
+			return manifest;
+		}
+
+		Asset();
+		Asset(const Asset&) = delete;
+		Asset& operator=(const Asset&) = delete;
+
+		virtual ~Asset() = default;
+
+		/// @return Путь к файлу ресурса. Используется в сообщениях об ошибках и в отчёте о времени загрузки
+		virtual const std::string& getPath() const noexcept = 0;
+
+		/**
+		 * @brief Читает и декодирует ресурс в оперативную память. Вызывается один раз из рабочего потока,
+		 * параллельно с загрузкой других ресурсов, поэтому не должна обращаться к OpenGL и к общим данным.
+		 * Данные передаются в OpenGL позже, в главном потоке
+		 * @throw std::exception если ресурс не удалось загрузить
+		 */
+		virtual void load() = 0;
+	};
+}
+
+#endif
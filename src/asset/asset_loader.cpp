@@ -0,0 +1,121 @@
+#include "asset_loader.h"
+#include "asset.h"
+#include "trace.h"
+
+#include <iostream>
+#include <iomanip>
+#include <numeric>
+#include <algorithm>
+
+namespace hack_game {
+	using std::cerr;
+	using std::endl;
+	using std::vector;
+	using std::ostream;
+	using std::exception_ptr;
+
+	using Milliseconds = std::chrono::duration<double, std::milli>;
+
+
+	AssetLoader::AssetLoader(unsigned threadCount):
+			results(Asset::getManifest().size()),
+			startTime(Clock::now()) {
+
+		if (threadCount == 0) {
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+		}
+
+		threadCount = std::min<size_t>(threadCount, results.size());
+		workers.reserve(threadCount);
+
+		for (unsigned i = 0; i < threadCount; i++) {
+			workers.emplace_back(&AssetLoader::work, this);
+		}
+	}
+
+	AssetLoader::~AssetLoader() {
+		for (std::thread& worker : workers) {
+			if (worker.joinable()) {
+				worker.join();
+			}
+		}
+	}
+
+
+	void AssetLoader::work() {
+		trace::setThreadName("asset loader");
+		const vector<Asset*>& manifest = Asset::getManifest();
+
+		for (size_t i = nextAsset++; i < manifest.size(); i = nextAsset++) {
+			// Ресурсы живут до конца программы, поэтому путь можно использовать как имя замера
+			TRACE_ZONE(manifest[i]->getPath().c_str());
+			const Clock::time_point start = Clock::now();
+
+			try {
+				manifest[i]->load();
+			} catch (...) {
+				results[i].error = std::current_exception();
+			}
+
+			results[i].time = Clock::now() - start;
+		}
+	}
+
+
+	static const char* getErrorMessage(const exception_ptr& error) {
+		try {
+			std::rethrow_exception(error);
+		} catch (const std::exception& exception) {
+			return exception.what();
+		} catch (...) {
+			return "unknown error";
+		}
+	}
+
+
+	void AssetLoader::wait(ostream* timingLog) {
+		{
+			TRACE_ZONE("waitAssets");
+
+			for (std::thread& worker : workers) {
+				worker.join();
+			}
+		}
+
+		const Clock::duration totalTime = Clock::now() - startTime;
+		const vector<Asset*>& manifest = Asset::getManifest();
+
+		bool failed = false;
+
+		for (size_t i = 0; i < manifest.size(); i++) {
+			if (results[i].error != nullptr) {
+				cerr << "Cannot load asset '" << manifest[i]->getPath() << "': " << getErrorMessage(results[i].error) << endl;
+				failed = true;
+			}
+		}
+
+		if (failed) {
+			exit(EXIT_FAILURE);
+		}
+
+		if (timingLog == nullptr) {
+			return;
+		}
+
+		// Самые долгие ресурсы идут первыми
+		vector<size_t> order(manifest.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [this] (size_t a, size_t b) { return results[a].time > results[b].time; });
+
+		Clock::duration sumTime {};
+		*timingLog << std::fixed << std::setprecision(2);
+
+		for (size_t i : order) {
+			*timingLog << std::setw(8) << Milliseconds(results[i].time).count() << " ms  " << manifest[i]->getPath() << '\n';
+			sumTime += results[i].time;
+		}
+
+		*timingLog << manifest.size() << " assets loaded in " << Milliseconds(totalTime).count() << " ms on "
+		           << workers.size() << " threads (" << Milliseconds(sumTime).count() << " ms in total)" << endl;
+	}
+}
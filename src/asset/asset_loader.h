@@ -0,0 +1,51 @@
+#ifndef HACK_GAME__ASSET__ASSET_LOADER_H
+#define HACK_GAME__ASSET__ASSET_LOADER_H
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <exception>
+
+namespace hack_game {
+
+	/**
+	 * @brief Этап загрузки ресурсов. Загружает все ресурсы из манифеста (Asset::getManifest) в пуле рабочих потоков.
+	 * Загрузка начинается сразу при создании объекта, так что главный поток тем временем может создавать
+	 * окно и контекст OpenGL
+	 */
+	class AssetLoader {
+		using Clock = std::chrono::steady_clock;
+
+		struct Result {
+			Clock::duration time {};
+			std::exception_ptr error;
+		};
+
+		std::vector<Result> results; // По одному на каждый ресурс манифеста
+		std::atomic<size_t> nextAsset = 0;
+		std::vector<std::thread> workers;
+		const Clock::time_point startTime;
+
+	public:
+		/// @brief Запускает загрузку в threadCount потоках. Если threadCount == 0, берётся количество ядер процессора
+		explicit AssetLoader(unsigned threadCount = 0);
+		~AssetLoader();
+
+		AssetLoader(const AssetLoader&) = delete;
+		AssetLoader& operator=(const AssetLoader&) = delete;
+
+		/**
+		 * @brief Ждёт окончания загрузки. Если какие-то ресурсы не загрузились, выводит ошибки по всем из них
+		 * и завершает программу
+		 * @param timingLog если не nullptr, в него записывается время загрузки каждого ресурса
+		 */
+		void wait(std::ostream* timingLog);
+
+	private:
+		void work();
+	};
+}
+
+#endif
@@ -3,8 +3,20 @@
 
 #define LEVELS_DIR            "resources/levels/"
 #define MODELS_DIR            "resources/models/"
-#define TEXTURES_DIR          "resources/textures/"
 #define SHADERS_DIR           "resources/shaders/"
 #define SHADERS_ANIMATION_DIR "resources/shaders/animation/"
 
+// Файлы .tex, которые texture_converter создаёт при сборке. CMake задаёт папку в каталоге сборки
+#ifndef TEXTURES_DIR
+#define TEXTURES_DIR          "resources/textures/"
+#endif
+
+// Файлы, которые игра создаёт сама и может пересоздать в любой момент
+#define CACHE_DIR             "cache/"
+#define MESH_CACHE_DIR        CACHE_DIR "meshes/"
+#define SHADER_CACHE_DIR      CACHE_DIR "shaders/"
+
+// Логи профилирования, которые читают скрипты show-*.py
+#define DEBUG_DIR             "debug/"
+
 #endif
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "entity/entity_with_pos.h"
 #include "shader/shader.h"
 #include "level/level.h"
+#include "render/draw_list.h"
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace hack_game {
@@ -29,10 +30,16 @@ namespace hack_game {
 	}
 
 
-	void Animation::draw() const {
-		shader.setUniform("centerPos", getPos());
-		shader.setUniform("progress", getProgress());
-		SimpleEntity::draw();
+	vec3 Animation::getTickOffset() const noexcept {
+		return entity->getTickOffset();
+	}
+
+
+	void Animation::draw(DrawList& drawList) const {
+		DrawCommand& command = drawList.add(shader, model, getModelTransform());
+		command.tickOffset = getTickOffset();
+		command.uniforms.set(uniform::centerPos, getPos());
+		command.uniforms.set(uniform::progress, getProgress());
 	}
 
 
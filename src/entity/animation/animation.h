@@ -45,8 +45,10 @@ namespace hack_game {
 			return true;
 		}
 
+		glm::vec3 getTickOffset() const noexcept override;
+
 		void tick(Level&) override;
-		void draw() const override;
+		void draw(DrawList&) const override;
 		glm::mat4 getModelTransform() const override;
 	
 	protected:
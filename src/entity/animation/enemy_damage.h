@@ -7,6 +7,8 @@ namespace hack_game {
 
 	class EnemyDamageAnimation: public BillboardAnimation {
 	public:
+		static constexpr size_t POOL_CAPACITY = 16;
+
 		EnemyDamageAnimation(std::shared_ptr<const EntityWithPos>&&, ShaderManager&) noexcept;
 	};
 }
@@ -4,6 +4,7 @@
 #include "entity/enemy.h"
 #include "shader/shader_manager.h"
 #include "level/level.h"
+#include "render/draw_list.h"
 #include "main/globals.h"
 #include "util.h"
 #include <glm/gtc/matrix_transform.hpp>
@@ -28,6 +29,8 @@ namespace hack_game {
 	static const float MIN_SPAWN_SIZE = 4 * TILE_SIZE;
 	static const float MAX_SPAWN_SIZE = 10 * TILE_SIZE;
 
+	static constexpr int MAX_CUBES_PER_BATCH = 32; // При частоте тиков по умолчанию за тик появляется не больше 3 кубов
+
 
 	// ------------------------------------------- Cube -------------------------------------------
 
@@ -57,14 +60,14 @@ namespace hack_game {
 
 	// ---------------------------------- EnemyDestroyAnimation -----------------------------------
 
-	EnemyDestroyAnimation::EnemyDestroyAnimation(std::shared_ptr<const EntityWithPos>&& entity, ShaderManager& shaderManager) noexcept:
+	EnemyDestroyAnimation::EnemyDestroyAnimation(std::shared_ptr<const EntityWithPos>&& entity, Level& level, ShaderManager& shaderManager) noexcept:
 			FlatAndBillboardAnimation(
 				std::move(entity), shaderManager,
 				shaderManager.getShader("enemyDestroyFlat"), shaderManager.getShader("enemyDestroyBillboard"),
 				DURATION, SIZE, Enemy::RADIUS, models::enemyDestroyBillboard
 			),
 			particleShader  (shaderManager.getShader("particleCube")),
-			seed            (randomInt32()) {
+			seed            (level.getRandom().nextInt32()) {
 		
 		destroyAnimationCount += 1;
 	}
@@ -90,45 +93,47 @@ namespace hack_game {
 	}
 
 
-	static void addCube(float time, const vec3& pos, vector<Cube>& fadingCubes, vector<Cube>& solidCubes, vector<Cube>& frameCubes) {
-		const float spawnSize = zoom(time, CUBES_START, CUBES_END, MIN_SPAWN_SIZE, MAX_SPAWN_SIZE);
-
-		const vec3 cubePos = randomBetween(
-				vec3(pos.x - spawnSize, pos.y, pos.z - spawnSize),
-				pos + spawnSize
-		);
-
-		const float angle = randomBetween(0.0f, glm::radians(360.0f));
-		const vec3 axis = glm::normalize(randomBetween(vec3(-1.0f), vec3(1.0f)));
+	/// @brief Добавляет count кубов. Случайные значения генерируются пачками, как в MinionDestroyAnimation
+	static void addCubes(Random& random, int count, float time, const vec3& pos, vector<Cube>& fadingCubes, vector<Cube>& solidCubes, vector<Cube>& frameCubes) {
+		assert(count <= MAX_CUBES_PER_BATCH);
 
+		const float spawnSize = zoom(time, CUBES_START, CUBES_END, MIN_SPAWN_SIZE, MAX_SPAWN_SIZE);
 		const float minScale = zoom(time, CUBES_START, CUBES_END, 0.25f, 0.05f);
 		const float maxScale = zoom(time, CUBES_START, CUBES_END, 0.5f, 0.1f);
-		const float scale = randomBetween(minScale, maxScale);
-
-		float lifetime;
-		vector<Cube>* cubes;
-
-		switch ((rand() >> 8) & 0x7) {
-			case 0: case 1: case 2: case 3: case 4:
-				lifetime = randomBetween(0.05f, 0.3f);
-				cubes = &fadingCubes;
-				break;
-			
-			case 5: case 6:
-				lifetime = randomBetween(0.05f, 0.2f);
-				cubes = &solidCubes;
-				break;
-			
-			case 7:
-				lifetime = randomBetween(0.05f, 0.1f);
-				cubes = &frameCubes;
-				break;
-			
-			default:
-				return;
-		}
 
-		cubes->emplace_back(cubePos, angle, axis, scale, lifetime);
+		vec3 positions[MAX_CUBES_PER_BATCH], axes[MAX_CUBES_PER_BATCH];
+		float angles[MAX_CUBES_PER_BATCH], scales[MAX_CUBES_PER_BATCH], kinds[MAX_CUBES_PER_BATCH], lifetimes[MAX_CUBES_PER_BATCH];
+
+		random.fillVec3s(positions, count, vec3(pos.x - spawnSize, pos.y, pos.z - spawnSize), pos + spawnSize);
+		random.fillFloats(angles,   count, 0.0f, glm::radians(360.0f));
+		random.fillVec3s(axes,      count, vec3(-1.0f), vec3(1.0f));
+		random.fillFloats(scales,   count, minScale, maxScale);
+		random.fillFloats(kinds,    count, 0.0f, 8.0f);
+		random.fillFloats(lifetimes, count, 0.0f, 1.0f);
+
+		for (int i = 0; i < count; i++) {
+			float lifetime;
+			vector<Cube>* cubes;
+
+			switch (static_cast<int>(kinds[i])) {
+				case 0: case 1: case 2: case 3: case 4:
+					lifetime = std::lerp(0.05f, 0.3f, lifetimes[i]);
+					cubes = &fadingCubes;
+					break;
+				
+				case 5: case 6:
+					lifetime = std::lerp(0.05f, 0.2f, lifetimes[i]);
+					cubes = &solidCubes;
+					break;
+				
+				default:
+					lifetime = std::lerp(0.05f, 0.1f, lifetimes[i]);
+					cubes = &frameCubes;
+					break;
+			}
+
+			cubes->emplace_back(positions[i], angles[i], glm::normalize(axes[i]), scales[i], lifetime);
+		}
 	}
 	
 
@@ -137,10 +142,13 @@ namespace hack_game {
 
 		if (time >= CUBES_START && time <= CUBES_END) {
 
-			const int newCubes = static_cast<int>(randomBetween(1, 20) * randomBetween(1, 20) * level.getDeltaTime());
+			Random& random = level.getRandom();
+			int newCubes = static_cast<int>(random.nextInt(1, 20) * random.nextInt(1, 20) * level.getDeltaTime());
 
-			for (int i = 0; i < newCubes; i++) {
-				addCube(time, getPos(), fadingCubes, solidCubes, frameCubes);
+			while (newCubes > 0) {
+				const int count = std::min(newCubes, MAX_CUBES_PER_BATCH);
+				addCubes(random, count, time, getPos(), fadingCubes, solidCubes, frameCubes);
+				newCubes -= count;
 			}
 		}
 		
@@ -153,35 +161,34 @@ namespace hack_game {
 	// ------------------------------------------- draw -------------------------------------------
 
 
-	static void drawCubes(Shader& particleShader, const vector<Cube>& cubes, Mode mode, Model& model, float minScale) {
-		particleShader.setUniform("mode", static_cast<GLuint>(mode));
-			
+	/// @brief Рисует все кубы списка одной инстансной командой
+	static void drawCubes(DrawList& drawList, Shader& particleShader, const vector<Cube>& cubes, Mode mode, Model& model, float minScale, const mat4& transform) {
+		if (cubes.empty()) return;
+
+		drawList.addInstanced(particleShader, model, transform);
+
 		for (const Cube& cube : cubes) {
 			float progress = cube.lifetime / cube.maxLifetime;
 			mat4 modelMat = glm::scale(cube.modelMat, vec3(cube.scale * std::lerp(1.0f, minScale, progress)));
-			
-			particleShader.setModel(modelMat);
-			particleShader.setUniform("alpha", std::exp(-6.0f * progress));
 
-			model.draw(particleShader);
+			drawList.addInstance(modelMat, glm::vec4(std::exp(-6.0f * progress), static_cast<float>(mode), 0.0f, 0.0f));
 		}
 	}
 	
 
-	void EnemyDestroyAnimation::draw() const {
-		FlatAndBillboardAnimation::draw();
+	void EnemyDestroyAnimation::draw(DrawList& drawList) const {
+		FlatAndBillboardAnimation::draw(drawList);
 
-		if (time >= CUBES_START && (!fadingCubes.empty() || !solidCubes.empty() || !frameCubes.empty())) {
-			particleShader.use();
-			particleShader.setView(getView());
+		if (time >= CUBES_START) {
+			const mat4 transform = glm::translate(mat4(1.0f), getPos());
 
-			drawCubes(particleShader, fadingCubes, Mode::FADING, models::blackCube, 1.0f);
-			drawCubes(particleShader, solidCubes,  Mode::SOLID,  models::blackCube, 0.9f);
-			drawCubes(particleShader, frameCubes,  Mode::SOLID,  models::cubeFrame, 0.8f);
+			drawCubes(drawList, particleShader, fadingCubes, Mode::FADING, models::blackCube, 1.0f, transform);
+			drawCubes(drawList, particleShader, solidCubes,  Mode::SOLID,  models::blackCube, 0.9f, transform);
+			drawCubes(drawList, particleShader, frameCubes,  Mode::SOLID,  models::cubeFrame, 0.8f, transform);
 		}
 	}
 
-	void EnemyDestroyAnimation::setFlatShaderUniforms() const {
-		flatShader.setUniform("seed", seed);
+	void EnemyDestroyAnimation::setFlatShaderUniforms(UniformList& uniforms) const {
+		uniforms.set(uniform::seed, seed);
 	}
 }
\ No newline at end of file
@@ -20,15 +20,15 @@ namespace hack_game {
 		const GLint seed;
 
 	public:
-		EnemyDestroyAnimation(std::shared_ptr<const EntityWithPos>&&, ShaderManager&) noexcept;
+		EnemyDestroyAnimation(std::shared_ptr<const EntityWithPos>&&, Level&, ShaderManager&) noexcept;
 		~EnemyDestroyAnimation();
 
 		void tick(Level&) override;
-		void draw() const override;
+		void draw(DrawList&) const override;
 	
 	protected:
 		void onRemove(Level&) override;
-		void setFlatShaderUniforms() const override;
+		void setFlatShaderUniforms(UniformList&) const override;
 	};
 }
 
@@ -1,5 +1,6 @@
 #include "flat_and_billboard_animation.h"
 #include "shader/shader_manager.h"
+#include "render/draw_list.h"
 
 namespace hack_game {
 
@@ -15,25 +16,22 @@ namespace hack_game {
 			billboardShader(billboardShader) {}
 	
 
-	void FlatAndBillboardAnimation::draw() const {
+	void FlatAndBillboardAnimation::draw(DrawList& drawList) const {
 		const vec3 pos = getPos();
+		const vec3 tickOffset = getTickOffset();
 		const float progress = getProgress();
 
-		flatShader.use();
-		flatShader.setView(getView());
-		flatShader.setModel(getFlatShaderModelTransform());
-		flatShader.setUniform("centerPos", pos);
-		flatShader.setUniform("progress", progress);
-		setFlatShaderUniforms();
-		model.draw(flatShader);
-
-		billboardShader.use();
-		billboardShader.setView(getView());
-		billboardShader.setModel(getBillboardShaderModelTransform());
-		billboardShader.setUniform("centerPos", pos);
-		billboardShader.setUniform("progress", progress);
-		setBillboardShaderUniforms();
-		model.draw(billboardShader);
+		DrawCommand& flat = drawList.add(flatShader, model, getFlatShaderModelTransform());
+		flat.tickOffset = tickOffset;
+		flat.uniforms.set(uniform::centerPos, pos);
+		flat.uniforms.set(uniform::progress, progress);
+		setFlatShaderUniforms(flat.uniforms);
+
+		DrawCommand& billboard = drawList.add(billboardShader, model, getBillboardShaderModelTransform());
+		billboard.tickOffset = tickOffset;
+		billboard.uniforms.set(uniform::centerPos, pos);
+		billboard.uniforms.set(uniform::progress, progress);
+		setBillboardShaderUniforms(billboard.uniforms);
 	}
 
 	mat4 FlatAndBillboardAnimation::getFlatShaderModelTransform() const {
@@ -5,6 +5,8 @@
 
 namespace hack_game {
 
+	class UniformList;
+
 	/**
 	 * @brief Отрисовывает модель с помощью двух шейдеров - flatShader и billboardShader.
 	 * Класс содержит всего одну модель (как правило, плоский квадрат), но применяет к ней разные матрицы трансформации и шейдеры.
@@ -22,8 +24,8 @@ namespace hack_game {
 		);
 
 		/// @brief Отрисовывает модель два раза: сначала с использованием flatShader, потом с использованием billboardShader
-		/// Перед отрисовкой устанавливает uniform-переменные view, model, centerPos, progress для каждого шейдера
-		void draw() const override;
+		/// Для каждого шейдера задаёт uniform-переменные model, centerPos, progress
+		void draw(DrawList&) const override;
 	
 	protected:
 		/// @return Матрицу трансформации плоской модели. По умолчанию, возвращает неповёрнутую матрицу (Animation::getModelTransform)
@@ -32,11 +34,11 @@ namespace hack_game {
 		/// @return Матрицу трансформации модели, обращённой в сторону камеры. По умолчанию, возвращает матрицу BillboardAnimation::getModelTransform
 		virtual glm::mat4 getBillboardShaderModelTransform() const;
 
-		/// @brief Устанавливает значения дополнительных uniform-переменные для flatShader. По умолчанию ничего не делает
-		virtual void setFlatShaderUniforms() const {}
+		/// @brief Задаёт значения дополнительных uniform-переменные для flatShader. По умолчанию ничего не делает
+		virtual void setFlatShaderUniforms(UniformList&) const {}
 
-		/// @brief Устанавливает значения дополнительных uniform-переменные для billboardShader. По умолчанию ничего не делает
-		virtual void setBillboardShaderUniforms() const {}
+		/// @brief Задаёт значения дополнительных uniform-переменные для billboardShader. По умолчанию ничего не делает
+		virtual void setBillboardShaderUniforms(UniformList&) const {}
 	};
 }
 
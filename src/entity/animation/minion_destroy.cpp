@@ -4,14 +4,15 @@
 #include "model/models.h"
 #include "shader/shader_manager.h"
 #include "level/level.h"
+#include "render/draw_list.h"
 #include "cube_particle_mode.h"
+#include "memory/object_pool.h"
 #include "util.h"
 
 namespace hack_game {
 	using std::sin;
 	using std::cos;
 	using std::shared_ptr;
-	using std::make_shared;
 
 	using glm::vec3;
 	using glm::mat4;
@@ -23,8 +24,6 @@ namespace hack_game {
 	static const float SIZE     = 1.0f;
 	static const float Y_OFFSET = 0.5f * TILE_SIZE;
 
-	static const int MAX_CUBES = 10;
-
 	static const float SKIP_CUBE_CHANCE = 0.15f;
 	static const float FRAME_MODE_CHANCE = 0.15f;
 
@@ -40,6 +39,8 @@ namespace hack_game {
 
 	class MinionDestroyAnimation::Cube: public Entity {
 	public:
+		static constexpr size_t POOL_CAPACITY = MinionDestroyAnimation::POOL_CAPACITY * MAX_CUBES;
+
 		MinionDestroyAnimation& parent;
 		vec3 offset;
 		vec3 speed;
@@ -72,15 +73,8 @@ namespace hack_game {
 			return true;
 		}
 
-		void draw() const override {
-			Shader& shader = parent.particleShader;
-			shader.setModel(getModelTransform());
-			shader.setUniform("alpha", std::min(1.0f, 2.0f - parent.time * (2.0f / DURATION)));
-			shader.setUniform("mode", static_cast<GLuint>(Mode::FADING));
-
-			const Model& model = isFrame ? models::cubeFrame : models::blackCube;
-			model.draw(shader);
-		}
+		/// Кубы рисуются родительской анимацией одной инстансной командой на каждую модель
+		void draw(DrawList&) const override {}
 	};
 
 
@@ -94,27 +88,33 @@ namespace hack_game {
 			),
 			particleShader  (shaderManager.getShader("particleCube")),
 			angleNormal     (0.0f, 1.0f, 0.0f),
-			seed            (randomInt32()) {
-		
+			seed            (level.getRandom().nextInt32()) {
 
-		cubes.reserve(MAX_CUBES);
+		float skipChances[MAX_CUBES], distances[MAX_CUBES], speeds[MAX_CUBES], scales[MAX_CUBES], frameChances[MAX_CUBES];
+
+		Random& random = level.getRandom();
+		random.fillFloats(skipChances,  MAX_CUBES, 0.0f, 1.0f);
+		random.fillFloats(distances,    MAX_CUBES, MIN_CUBE_DISTANCE, MAX_CUBE_DISTANCE);
+		random.fillFloats(speeds,       MAX_CUBES, MIN_CUBE_SPEED, MAX_CUBE_SPEED);
+		random.fillFloats(scales,       MAX_CUBES, 0.25f, 0.5f);
+		random.fillFloats(frameChances, MAX_CUBES, 0.0f, 1.0f);
 
 		for (int i = 0; i < MAX_CUBES; i++) {
-			if (randomBetween(0.0f, 1.0f) < SKIP_CUBE_CHANCE) {
+			if (skipChances[i] < SKIP_CUBE_CHANCE) {
 				continue;
 			}
 
 			const float angle    = i * (glm::radians(360.0f) / MAX_CUBES);
-			const float distance = randomBetween(MIN_CUBE_DISTANCE, MAX_CUBE_DISTANCE);
-			const float speed    = randomBetween(MIN_CUBE_SPEED, MAX_CUBE_SPEED);
-			const float scale    = randomBetween(0.25f, 0.5f);
-			const bool isFrame   = randomBetween(0.0f, 1.0f) < FRAME_MODE_CHANCE;
+			const float distance = distances[i];
+			const float speed    = speeds[i];
+			const float scale    = scales[i];
+			const bool isFrame   = frameChances[i] < FRAME_MODE_CHANCE;
 
 			const vec3 offset = vec3(0.0f, TILE_SIZE, 0.0f) + glm::rotate(vec3(distance, 0.0f, 0.0f), angle, vec3(0.0f, 1.0f, 0.0f));
 
-			auto cube = make_shared<Cube>(*this, offset, speed, scale, isFrame);
+			auto cube = makePooled<Cube>(*this, offset, speed, scale, isFrame);
 			level.addEntity(cube);
-			cubes.push_back(std::move(cube));
+			cubes[cubeCount++] = std::move(cube);
 		}
 	}
 
@@ -129,8 +129,33 @@ namespace hack_game {
 	}
 
 	void MinionDestroyAnimation::onRemove(Level& level) {
-		for (const shared_ptr<Cube>& cube : cubes) {
-			level.removeEntity(cube);
+		for (int i = 0; i < cubeCount; i++) {
+			level.removeEntity(cubes[i]);
+		}
+	}
+
+
+	void MinionDestroyAnimation::draw(DrawList& drawList) const {
+		FlatAndBillboardAnimation::draw(drawList);
+
+		drawCubes(drawList, models::blackCube, false);
+		drawCubes(drawList, models::cubeFrame, true);
+	}
+
+	void MinionDestroyAnimation::drawCubes(DrawList& drawList, const Model& model, bool isFrame) const {
+		const float alpha = std::min(1.0f, 2.0f - time * (2.0f / DURATION));
+		bool added = false;
+
+		for (int i = 0; i < cubeCount; i++) {
+			const Cube& cube = *cubes[i];
+			if (cube.isFrame != isFrame) continue;
+
+			if (!added) {
+				drawList.addInstanced(particleShader, model, glm::translate(mat4(1.0f), getPos()));
+				added = true;
+			}
+
+			drawList.addInstance(cube.getModelTransform(), glm::vec4(alpha, static_cast<float>(Mode::FADING), 0.0f, 0.0f));
 		}
 	}
 
@@ -139,8 +164,8 @@ namespace hack_game {
 		return glm::scale(FlatAndBillboardAnimation::getFlatShaderModelTransform(), vec3(0.3f));
 	}
 
-	void MinionDestroyAnimation::setBillboardShaderUniforms() const {
-		billboardShader.setUniform("angleNormal", angleNormal);
-		billboardShader.setUniform("seed", seed);
+	void MinionDestroyAnimation::setBillboardShaderUniforms(UniformList& uniforms) const {
+		uniforms.set(uniform::angleNormal, angleNormal);
+		uniforms.set(uniform::seed, seed);
 	}
 }
\ No newline at end of file
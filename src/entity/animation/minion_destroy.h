@@ -2,16 +2,20 @@
 #define HACK_GAME__ENTITY__ANIMATION__MINION_DESTROY_H
 
 #include "flat_and_billboard_animation.h"
-#include <vector>
+#include <array>
 
 namespace hack_game {
 
 	class MinionDestroyAnimation: public FlatAndBillboardAnimation {
 	public:
 		class Cube;
+
+		static constexpr size_t POOL_CAPACITY = 32;
+		static constexpr int MAX_CUBES = 10;
 	
 	private:
-		std::vector<std::shared_ptr<Cube>> cubes;
+		std::array<std::shared_ptr<Cube>, MAX_CUBES> cubes; // Массив фиксированного размера, чтобы не выделять память
+		int cubeCount = 0;
 		Shader& particleShader;
 		glm::vec3 angleNormal;
 		int32_t seed;
@@ -21,11 +25,16 @@ namespace hack_game {
 		~MinionDestroyAnimation();
 
 		void tick(Level&) override;
+		void draw(DrawList&) const override;
 	
 	protected:
 		glm::mat4 getFlatShaderModelTransform() const override;
-		void setBillboardShaderUniforms() const override;
+		void setBillboardShaderUniforms(UniformList&) const override;
 		void onRemove(Level&) override;
+
+	private:
+		/// @brief Рисует все кубы с заданной моделью одной инстансной командой
+		void drawCubes(DrawList&, const Model&, bool isFrame) const;
 	};
 }
 
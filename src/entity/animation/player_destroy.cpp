@@ -2,6 +2,7 @@
 #include "entity/player.h"
 #include "level/level.h"
 #include "shader/shader_manager.h"
+#include "render/draw_list.h"
 #include "main/globals.h"
 #include "util.h"
 #include <glm/common.hpp>
@@ -24,7 +25,7 @@ namespace hack_game {
 				scale(scale), maxLifetime(maxLifetime) {}
 	};
 
-	PlayerDestroyAnimation::PlayerDestroyAnimation(std::shared_ptr<const EntityWithPos>&& entity, ShaderManager& shaderManager):
+	PlayerDestroyAnimation::PlayerDestroyAnimation(std::shared_ptr<const EntityWithPos>&& entity, Level& level, ShaderManager& shaderManager):
 			FlatAndBillboardAnimation(
 				std::move(entity), shaderManager,
 				shaderManager.getShader("playerDestroyFlat"),
@@ -32,7 +33,7 @@ namespace hack_game {
 				DURATION, SIZE, Player::RADIUS
 			),
 			angleNormal(0.0f, 1.0f, 0.0f),
-			seed(randomInt32()) {
+			seed(level.getRandom().nextInt32()) {
 
 		destroyAnimationCount += 1;
 	}
@@ -55,12 +56,12 @@ namespace hack_game {
 		return glm::scale(FlatAndBillboardAnimation::getFlatShaderModelTransform(), vec3(0.1f));
 	}
 
-	void PlayerDestroyAnimation::setFlatShaderUniforms() const {
-		flatShader.setUniform("seed", seed);
+	void PlayerDestroyAnimation::setFlatShaderUniforms(UniformList& uniforms) const {
+		uniforms.set(uniform::seed, seed);
 	}
 
-	void PlayerDestroyAnimation::setBillboardShaderUniforms() const {
-		billboardShader.setUniform("angleNormal", angleNormal);
-		billboardShader.setUniform("seed", seed);
+	void PlayerDestroyAnimation::setBillboardShaderUniforms(UniformList& uniforms) const {
+		uniforms.set(uniform::angleNormal, angleNormal);
+		uniforms.set(uniform::seed, seed);
 	}
 }
\ No newline at end of file
@@ -15,7 +15,7 @@ namespace hack_game {
 		const GLint seed;
 
 	public:
-		PlayerDestroyAnimation(std::shared_ptr<const EntityWithPos>&&, ShaderManager&);
+		PlayerDestroyAnimation(std::shared_ptr<const EntityWithPos>&&, Level&, ShaderManager&);
 		~PlayerDestroyAnimation();
 
 		void tick(Level&) override;
@@ -23,8 +23,8 @@ namespace hack_game {
 	protected:
 		void onRemove(Level&) override;
 		glm::mat4 getFlatShaderModelTransform() const override;
-		void setFlatShaderUniforms() const override;
-		void setBillboardShaderUniforms() const override;
+		void setFlatShaderUniforms(UniformList&) const override;
+		void setBillboardShaderUniforms(UniformList&) const override;
 	};
 }
 
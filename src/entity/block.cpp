@@ -2,6 +2,7 @@
 #include "model/models.h"
 #include "shader/shader.h"
 #include "level/level.h"
+#include "render/draw_list.h"
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -46,6 +47,10 @@ namespace hack_game {
 		return getHitbox().containsInclusive(vec2(pos.x, pos.z));
 	}
 
+	vec3 Block::getHitboxCenter() const noexcept {
+		return vec3((pos.x + 0.5f) * TILE_SIZE, 0.0f, (pos.y + 0.5f) * TILE_SIZE);
+	}
+
 
 	const float DAMAGE_ANIMATION_DURATION = 0.25f;
 
@@ -71,7 +76,7 @@ namespace hack_game {
 		}
 	}
 
-	void Block::draw() const {
+	void Block::draw(DrawList& drawList) const {
 		mat4 modelMat(1.0f);
 		modelMat = glm::translate(modelMat, vec3(
 			(pos.x + 0.5f) * TILE_SIZE,
@@ -79,9 +84,7 @@ namespace hack_game {
 			(pos.y + 0.5f) * TILE_SIZE
 		));
 
-		shader.setModel(modelMat);
-
 		float brightness = max(0.0f, damageAnimationTime * (1.25f / DAMAGE_ANIMATION_DURATION));
-		coloredModel.draw(shader, coloredModel.getColor() + brightness);
+		drawList.add(shader, coloredModel, modelMat).color = coloredModel.getColor() + brightness;
 	}
 }
\ No newline at end of file
@@ -26,9 +26,10 @@ namespace hack_game {
 		AABB getHitbox() const;
 		
 		bool hasCollision(const glm::vec3& point) const override;
+		glm::vec3 getHitboxCenter() const noexcept override;
 		void damage(Level&, hp_t damage) override;
 		void tick(Level&) override;
-		void draw() const override;
+		void draw(DrawList&) const override;
 	
 	protected:
 		void onDestroy(Level&) override;
@@ -5,6 +5,7 @@
 #include "model/models.h"
 #include "shader/shader.h"
 #include "level/level.h"
+#include "render/draw_list.h"
 #include "util.h"
 
 #include <glm/gtc/matrix_transform.hpp>
@@ -37,7 +38,8 @@ namespace hack_game {
 			pos(pos) {}
 
 	void Bullet::tick(Level& level) {
-		pos += velocity * level.getDeltaTime();
+		tickOffset = velocity * level.getDeltaTime();
+		pos += tickOffset;
 
 		if (checkCollision(level)) {
 			level.removeEntity(shared_from_this());
@@ -51,6 +53,12 @@ namespace hack_game {
 		}
 	}
 
+	void Bullet::draw(DrawList& drawList) const {
+		DrawCommand& command = drawList.add(shader, model, getModelTransform());
+		command.tickOffset = tickOffset;
+		command.instanced = true;
+	}
+
 	mat4 Bullet::getModelTransform() const {
 		mat4 model(1.0f);
 		model = glm::translate(model, pos);
@@ -91,11 +99,10 @@ namespace hack_game {
 			return true;
 		}
 
-		for (const auto& damageable : level.getDamageableEnemyEntities()) {
-			if (!damageable->destroyed() && damageable->hasCollision(pos)) {
-				damageable->damage(level, 1);
-				return true;
-			}
+		Damageable* damageable = level.getDamageableEnemyGrid().findCollision(pos);
+		if (damageable != nullptr) {
+			damageable->damage(level, 1);
+			return true;
 		}
 
 		return false;
@@ -119,6 +126,12 @@ namespace hack_game {
 	}
 
 
+	void EnemyBullet::tick(Level& level) {
+		Bullet::tick(level);
+		level.moveDamageable(*this);
+	}
+
+
 	bool EnemyBullet::hasCollision(const vec3& point) const {
 		return isPointInsideSphere(point, pos, ENEMY_BULLET_RADIUS);
 	}
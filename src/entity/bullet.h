@@ -7,11 +7,16 @@
 
 namespace hack_game {
 
+	/**
+	 * @brief Снаряд. Рисуется инстансно, поэтому шейдер должен принимать матрицу модели и цвет
+	 * как атрибуты экземпляра (например, шейдер lightInstanced)
+	 */
 	class Bullet: public SimpleEntity, public virtual std::enable_shared_from_this<Entity> {
 	protected:
 		const float angle;
 		const glm::vec3 velocity;
 		glm::vec3 pos;
+		glm::vec3 tickOffset {0.0f}; // Смещение за последний тик, нужно для интерполяции при отрисовке
 
 	public:
 		Bullet(Shader& shader, const Model& model, float angle, const glm::vec3& velocity, const glm::vec3& pos) noexcept;
@@ -20,7 +25,12 @@ namespace hack_game {
 			return pos;
 		}
 		
+		glm::vec3 getTickOffset() const noexcept override {
+			return tickOffset;
+		}
+
 		void tick(Level&) override;
+		void draw(DrawList&) const override;
 		glm::mat4 getModelTransform() const override;
 	
 	protected:
@@ -34,6 +44,8 @@ namespace hack_game {
 
 	class PlayerBullet: public Bullet {
 	public:
+		static constexpr size_t POOL_CAPACITY = 128;
+
 		PlayerBullet(Shader& shader, float angle, const glm::vec3& velocity, const glm::vec3& pos);
 
 	protected:
@@ -44,12 +56,19 @@ namespace hack_game {
 	class EnemyBullet: public Bullet, public Damageable {
 	public:
 		static constexpr float DEFAULT_SPEED = 0.15f;
+		static constexpr size_t POOL_CAPACITY = 512;
 
 		EnemyBullet(Shader& shader, bool unbreakable, const glm::vec3& velocity, const glm::vec3& pos);
 	
 		glm::mat4 getModelTransform() const override;
 		bool hasCollision(const glm::vec3& point) const override;
 
+		glm::vec3 getHitboxCenter() const noexcept override {
+			return pos;
+		}
+
+		void tick(Level&) override;
+
 	protected:
 		void onDestroy(Level&) override;
 		bool checkCollision(Level&) override;
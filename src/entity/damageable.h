@@ -3,6 +3,7 @@
 
 #include "entity.h"
 #include <memory>
+#include <cstdint>
 #include <glm/vec3.hpp>
 
 namespace hack_game {
@@ -20,6 +21,14 @@ namespace hack_game {
 	 * Сущность может быть неуязвимой - в таком случае по ней можно попасть, но урон нанесён не будет
 	 */
 	class Damageable: public virtual Entity, public virtual std::enable_shared_from_this<Entity> {
+		friend class SpatialGrid;
+
+		static constexpr size_t NO_GRID_CELL = SIZE_MAX;
+
+		// Положение в SpatialGrid хранится в самой сущности, чтобы добавление и удаление не выделяли память
+		size_t gridCell = NO_GRID_CELL; // Индекс ячейки или NO_GRID_CELL, если сущности нет в сетке
+		size_t gridSlot = 0;            // Индекс сущности в ячейке
+
 	protected:
 		const Side side;
 		hp_t hitpoints;
@@ -42,6 +51,10 @@ namespace hack_game {
 		 */
 		virtual bool hasCollision(const glm::vec3& point) const = 0;
 
+		/// @return Центр хитбокса. Используется для поиска сущности в SpatialGrid,
+		/// поэтому хитбокс не должен выходить за пределы TILE_SIZE от центра по осям x и z
+		virtual glm::vec3 getHitboxCenter() const noexcept = 0;
+
 		/// @brief Наносит урон по сущности, если она не неуязвимая
 		virtual void damage(Level&, hp_t damage);
 
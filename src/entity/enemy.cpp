@@ -6,7 +6,9 @@
 #include "model/models.h"
 #include "shader/shader_manager.h"
 #include "level/level.h"
+#include "render/draw_list.h"
 #include "main/globals.h"
+#include "memory/object_pool.h"
 #include "util.h"
 
 #include <glm/gtx/vector_angle.hpp>
@@ -51,13 +53,13 @@ namespace hack_game {
 		if (destroyed()) {
 			enemyDestroyed = true;
 
-			animation = make_shared<EnemyDestroyAnimation>(std::move(shared_from_this()), shaderManager);
+			animation = make_shared<EnemyDestroyAnimation>(std::move(shared_from_this()), level, shaderManager);
 			level.addEntity(animation);
 			level.removeEntity(shared_entity::shared_from_this());
 
 		} else if (animation == nullptr || animation->isFinished()) {
 
-			animation = make_shared<EnemyDamageAnimation>(std::move(shared_from_this()), shaderManager);
+			animation = makePooled<EnemyDamageAnimation>(std::move(shared_from_this()), shaderManager);
 			level.addEntity(animation);
 		}
 	}
@@ -72,18 +74,13 @@ namespace hack_game {
 		}
 	}
 
-	void Enemy::draw() const {
+	void Enemy::draw(DrawList& drawList) const {
 		bool bright = animation != nullptr && animation->getTime() <= BRIGHT_DURATION;
 
-		if (bright) {
-			shader.setUniform("modelBrightness", 1.5f);
-		}
-		
-		shader.setModel(getModelTransform());
-		coloredModel.draw(shader);
+		DrawCommand& command = drawList.add(shader, coloredModel, getModelTransform());
 
 		if (bright) {
-			shader.setUniform("modelBrightness", 1.0f);
+			command.brightness = 1.5f;
 		}
 	}
 
@@ -115,8 +112,8 @@ namespace hack_game {
 		for (int i = 0; i < 5; i++) {
 			vec2 velocity = glm::rotate(velocity0, angle + glm::radians(-90.0f + i * 45));
 
-			level.addEntity(make_shared<EnemyBullet>(
-				shaderManager.getShader("light"), spawnUnbreakable, vec3(velocity.x, 0.0f, velocity.y), pos
+			level.addEntity(makePooled<EnemyBullet>(
+				shaderManager.getShader("lightInstanced"), spawnUnbreakable, vec3(velocity.x, 0.0f, velocity.y), pos
 			));
 		}
 
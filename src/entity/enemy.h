@@ -31,11 +31,15 @@ namespace hack_game {
 		const glm::vec3& getPos() const noexcept override {
 			return pos;
 		}
+
+		glm::vec3 getHitboxCenter() const noexcept override {
+			return pos;
+		}
 		
 		bool hasCollision(const glm::vec3& point) const override;
 		void damage(Level&, hp_t damage) override;
 		void tick(Level&) override;
-		void draw() const override;
+		void draw(DrawList&) const override;
 		glm::mat4 getModelTransform() const override;
 
 		std::shared_ptr<const Enemy> shared_from_this() const;
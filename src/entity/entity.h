@@ -2,6 +2,7 @@
 #define HACK_GAME__ENTITY__ENTITY_H
 
 #include "gl_fwd.h"
+#include "level/slot_map.h"
 #include <glm/vec3.hpp>
 
 namespace hack_game {
@@ -10,11 +11,17 @@ namespace hack_game {
 	class Shader;
 	class ShaderManager;
 	class Level;
+	class DrawList;
 
 	/**
 	 * @brief Класс сущности. Сущность - это объект на сцене. Она может иметь своё состояние и кастомный код отрисовки
 	 */
 	class Entity {
+		friend class Level;
+
+		/// Положение сущности в хранилище уровня. Устанавливается уровнем при добавлении сущности
+		SlotHandle levelHandle;
+
 	protected:
 		constexpr Entity() = default;
 
@@ -28,8 +35,15 @@ namespace hack_game {
 		/// @brief Обновляет состояние сущности
 		virtual void tick(Level&) = 0;
 		
-		/// @brief Отрисовывает сущность в текущий фреймбуфер
-		virtual void draw() const = 0;
+		/// @brief Записывает команды отрисовки сущности. Вызывается в потоке симуляции после тика,
+		/// сами команды выполняются позже в потоке OpenGL
+		virtual void draw(DrawList&) const = 0;
+
+		/// @return Смещение сущности за последний тик. Используется для интерполяции позиции при отрисовке.
+		/// По умолчанию возвращает нулевой вектор
+		virtual glm::vec3 getTickOffset() const noexcept {
+			return glm::vec3(0.0f);
+		}
 
 		/// @return true, если у сущности есть (или может быть) альфа-канал. По умолчанию возвращает false.
 		/// @note Этот метод должен всегда возвращать одинаковое значение для одной сущности,
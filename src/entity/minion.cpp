@@ -5,12 +5,12 @@
 #include "model/models.h"
 #include "level/level.h"
 #include "shader/shader_manager.h"
+#include "memory/object_pool.h"
 #include "util.h"
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace hack_game {
 	using std::isnan;
-	using std::make_shared;
 	using glm::vec2;
 	using glm::vec3;
 	using glm::mat4;
@@ -32,6 +32,8 @@ namespace hack_game {
 
 	
 	void Minion::tick(Level& level) {
+		tickOffset = vec3(0.0f);
+
 		if (!level.getPlayer()->destroyed()) {
 			float newAngle = horizontalAngleBetween(pos, level.getPlayer()->getPos());
 			if (!isnan(newAngle))
@@ -39,7 +41,9 @@ namespace hack_game {
 			
 			vec2 offset = glm::rotate(level.getDeltaTime() * MINION_SPEED * ANGLE_NORMAL, angle);
 			offset = resolveBlockCollision(level, vec2(pos.x, pos.z), offset);
-			pos += vec3(offset.x, 0, offset.y);
+			tickOffset = vec3(offset.x, 0, offset.y);
+			pos += tickOffset;
+			level.moveDamageable(*this);
 		}
 
 		if (level.getPlayer()->destroyed()) return;
@@ -51,8 +55,8 @@ namespace hack_game {
 
 			vec2 velocity = glm::rotate(ANGLE_NORMAL * EnemyBullet::DEFAULT_SPEED, angle);
 			
-			level.addEntity(make_shared<EnemyBullet>(
-				shaderManager.getShader("light"), false, vec3(velocity.x, 0, velocity.y), pos
+			level.addEntity(makePooled<EnemyBullet>(
+				shaderManager.getShader("lightInstanced"), false, vec3(velocity.x, 0, velocity.y), pos
 			));
 		}
 	}
@@ -71,6 +75,6 @@ namespace hack_game {
 
 	void Minion::onDestroy(Level& level) {
 		Damageable::onDestroy(level);
-		level.addEntity(make_shared<MinionDestroyAnimation>(shared_from_this(), level, shaderManager));
+		level.addEntity(makePooled<MinionDestroyAnimation>(shared_from_this(), level, shaderManager));
 	}
 }
\ No newline at end of file
@@ -10,6 +10,7 @@ namespace hack_game {
 	class Minion: public SimpleEntity, public Damageable, public EntityWithPos {
 		ShaderManager& shaderManager;
 		glm::vec3 pos;
+		glm::vec3 tickOffset {0.0f}; // Смещение за последний тик, нужно для интерполяции при отрисовке
 		float angle = 0;
 		float time = 0;
 
@@ -20,6 +21,14 @@ namespace hack_game {
 			return pos;
 		}
 
+		glm::vec3 getHitboxCenter() const noexcept override {
+			return pos;
+		}
+
+		glm::vec3 getTickOffset() const noexcept override {
+			return tickOffset;
+		}
+
 		std::shared_ptr<const Minion> shared_from_this() const;
 
 		void tick(Level&) override;
@@ -6,14 +6,14 @@
 #include "model/models.h"
 #include "shader/shader_manager.h"
 #include "level/level.h"
+#include "render/draw_list.h"
 #include "main/globals.h"
+#include "memory/object_pool.h"
 #include "util.h"
 
-#include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
-#include "nowarn_imgui.h"
 
 namespace hack_game {
 	using std::max;
@@ -74,123 +74,30 @@ namespace hack_game {
 		}
 	}
 
-	void Player::updateKeys() {
-		up    = ImGui::IsKeyDown(ImGuiKey_W);
-		left  = ImGui::IsKeyDown(ImGuiKey_A);
-		down  = ImGui::IsKeyDown(ImGuiKey_S);
-		right = ImGui::IsKeyDown(ImGuiKey_D);
-		fire  = ImGui::IsKeyDown(ImGuiKey_LeftShift);
-
-		if (ImGui::IsKeyPressed(ImGuiKey_UpArrow, false))    updateAngle(glm::radians(0.f));
-		if (ImGui::IsKeyPressed(ImGuiKey_LeftArrow, false))  updateAngle(glm::radians(90.f));
-		if (ImGui::IsKeyPressed(ImGuiKey_DownArrow, false))  updateAngle(glm::radians(180.f));
-		if (ImGui::IsKeyPressed(ImGuiKey_RightArrow, false)) updateAngle(glm::radians(270.f));
-	}
-
-
-	// -------------------------------------- collisions ---------------------------------------
-
-	static constexpr float INF = std::numeric_limits<float>::infinity();
-	static constexpr float NaN = std::numeric_limits<float>::quiet_NaN();
-
-
-	/**
-	 * Ищет точку пересечения отрезка и окружности. Если таких две, возвращает любую из них.
-	 * @param[in] pos Первая точка отрезка
-	 * @param[in] offset Смещение от первой точки отрезка до второй
-	 * @param[in] center Центр окружности
-	 * @param[in] center Радиус окружности
-	 * @return Точку пересечения отрезка и окружности. Если её нет, возвращает `vec2(NaN)`.
-	 *         Точка может быть за пределами отрезка максимум на @ref EPSILON по обоим осям x и y.
-	 */
-	static constexpr vec2 getIntersectPoint(const vec2& pos, const vec2& offset, const vec2& center, float radius) {
-		const float cx = center.x;
-		const float cy = center.y;
-
-		if (offset.x == 0) {
-			const float A = 1;
-			const float B = -2 * cy;
-			const float C = powf(pos.x - cx, 2) + cy*cy - radius*radius;
-
-			const float D = B*B - 4*A*C;
-			if (D < 0) {
-				return vec2(NaN);
-			}
-
-			const float sqrtD = sqrt(D);
-
-			const float y1 = (-B + sqrtD) / (2*A);
-			const float y2 = (-B - sqrtD) / (2*A);
-
-			const vec2 newPos = pos + offset;
-
-			if (y1 >= min(pos.y, newPos.y) && y1 <= max(pos.y, newPos.y)) {
-				return vec2(pos.x, y1);
-			}
-
-			if (y2 >= min(pos.y, newPos.y) && y2 <= max(pos.y, newPos.y)) {
-				return vec2(pos.x, y2);
-			}
-
-			return vec2(NaN);
-		}
-
-		const float a = offset.x == 0 ? INF : offset.y / offset.x;
-		const float b = pos.y - a * pos.x;
-
-		const float A = a*a + 1;
-		const float B = 2 * (a * (b - cy) - cx);
-		const float C = powf(b - cy, 2) + cx*cx - radius*radius;
+	void Player::setInput(const PlayerInput& input) {
+		up    = input.up;
+		left  = input.left;
+		down  = input.down;
+		right = input.right;
+		fire  = input.fire;
 
-		const float D = B*B - 4*A*C;
-		if (D < 0) {
-			return vec2(NaN);
+		switch (input.turn) {
+			case PlayerInput::Turn::NONE:  break;
+			case PlayerInput::Turn::UP:    updateAngle(glm::radians(0.f));   break;
+			case PlayerInput::Turn::LEFT:  updateAngle(glm::radians(90.f));  break;
+			case PlayerInput::Turn::DOWN:  updateAngle(glm::radians(180.f)); break;
+			case PlayerInput::Turn::RIGHT: updateAngle(glm::radians(270.f)); break;
 		}
-
-		const float sqrtD = sqrt(D);
-
-		const float x1 = (-B + sqrtD) / (2*A);
-		const float x2 = (-B - sqrtD) / (2*A);
-
-		const float y1 = a * x1 + b;
-		const float y2 = a * x2 + b;
-
-		const vec2 newPos = pos + offset;
-		const float minX = min(pos.x, newPos.x) - EPSILON;
-		const float minY = min(pos.y, newPos.y) - EPSILON;
-		const float maxX = max(pos.x, newPos.x) + EPSILON;
-		const float maxY = max(pos.y, newPos.y) + EPSILON;
-
-		if (x1 >= minX && x1 <= maxX &&
-			y1 >= minY && y1 <= maxY) {
-			return vec2(x1, y1);
-		}
-
-		if (x1 != x2 &&
-			x2 >= minX && x2 <= maxX &&
-			y2 >= minY && y2 <= maxY) {
-			return vec2(x2, y2);
-		}
-
-		return vec2(NaN);
 	}
 
-	static constexpr bool all_isnan(const vec2& v) {
-		return isnan(v.x) && isnan(v.y);
-	}
-
-	static_assert(getIntersectPoint(vec2(1, 1), vec2(0, -2), vec2(0, 0), 1) == vec2(1, 0));
-	static_assert(all_isnan(getIntersectPoint(vec2(2, 1), vec2(0, -2), vec2(0, 0), 1)));
-
-	static_assert(getIntersectPoint(vec2(0, 0), vec2(1, 1), vec2(0, 0), 1) == vec2(sqrt(0.5f), sqrt(0.5f)));
-	static_assert(all_isnan(getIntersectPoint(vec2(1, 1), vec2(2, 2), vec2(0, 0), 1)));
 
+	// -------------------------------------- collisions ---------------------------------------
 
 	static constexpr vec2 getXZ(const vec3& pos) {
 		return vec2(pos.x, pos.z);
 	}
 
-	static vec2 resolveEnemyCollision(const Level& level, const vec2& pos, vec2 offset) {
+	vec2 resolveEnemyCollision(const Level& level, const vec2& pos, vec2 offset) {
 		if (level.getEnemy()->destroyed()) {
 			return offset;
 		}
@@ -250,7 +157,9 @@ namespace hack_game {
 
 
 	void Player::tick(Level& level) {
+		const vec3 prevPos = pos;
 		move(level);
+		tickOffset = pos - prevPos;
 
 		if (angle != targetAngle) {
 			float delta = glm::radians(ROTATE_SPEED) * level.getDeltaTime();
@@ -271,8 +180,8 @@ namespace hack_game {
 			vec3 velocity = rotateQuat * vec3(0.0f, 0.0f, -1.0f) * BULLET_SPEED;
 			vec3 bulletPos = pos + velocity * (TILE_SIZE * 0.5f);
 
-			level.addEntity(make_shared<PlayerBullet>(
-				shaderManager.getShader("light"), angle, velocity, bulletPos
+			level.addEntity(makePooled<PlayerBullet>(
+				shaderManager.getShader("lightInstanced"), angle, velocity, bulletPos
 			));
 		}
 	}
@@ -285,27 +194,23 @@ namespace hack_game {
 
 	// ------------------------------------------- draw -------------------------------------------
 
-	void Player::draw() const {
+	void Player::draw(DrawList& drawList) const {
 		mat4 modelMat(1.0f);
 		modelMat = translate(modelMat, pos);
 		modelMat = rotate(modelMat, angle, vec3(0.0f, 1.0f, 0.0f));
 
-		Shader& mainShader = shaderManager.mainShader;
+		const Model& model =
+				hitpoints >= 3 ? models::player3hp :
+				hitpoints == 2 ? models::player2hp :
+				                 models::player1hp;
 
-		mainShader.setModel(modelMat);
+		DrawCommand& command = drawList.add(shaderManager.mainShader, model, modelMat);
+		command.tickOffset = tickOffset;
 
 		bool isDark = animation != nullptr && !animation->isFinished() && animation->getTime() <= DARK_DURATION + FADE_DURATION;
 
 		if (isDark) {
-			mainShader.setUniform("modelBrightness", clamp(invLerp(animation->getTime(), DARK_DURATION, DARK_DURATION + FADE_DURATION), 0.0f, 1.0f));
-		}
-
-		if (hitpoints >= 3) models::player3hp.draw(mainShader);
-		if (hitpoints == 2) models::player2hp.draw(mainShader);
-		if (hitpoints <= 1) models::player1hp.draw(mainShader);
-
-		if (isDark) {
-			mainShader.setUniform("modelBrightness", 1.0f);
+			command.brightness = clamp(invLerp(animation->getTime(), DARK_DURATION, DARK_DURATION + FADE_DURATION), 0.0f, 1.0f);
 		}
 	}
 
@@ -316,7 +221,7 @@ namespace hack_game {
 		Damageable::damage(level, damage);
 
 		if (destroyed()) {
-			animation = make_shared<PlayerDestroyAnimation>(std::move(shared_from_this()), shaderManager);
+			animation = make_shared<PlayerDestroyAnimation>(std::move(shared_from_this()), level, shaderManager);
 			level.addEntity(animation);
 			level.removeEntity(shared_entity::shared_from_this());
 
@@ -9,6 +9,21 @@ namespace hack_game {
 
 	class Animation;
 
+	/// Состояние управления игроком. Считывается в потоке OpenGL и применяется в потоке симуляции перед тиком
+	struct PlayerInput {
+		/// Направление, в которое нужно повернуть игрока
+		enum class Turn: uint8_t {
+			NONE, UP, LEFT, DOWN, RIGHT
+		};
+
+		bool up    = false;
+		bool down  = false;
+		bool left  = false;
+		bool right = false;
+		bool fire  = false;
+		Turn turn  = Turn::NONE;
+	};
+
 	class Player final: public Damageable, public EntityWithPos {
 	public:
 		static constexpr float RADIUS = 0.02f;
@@ -20,6 +35,7 @@ namespace hack_game {
 
 		std::shared_ptr<Animation> animation = nullptr;
 		glm::vec3 pos;
+		glm::vec3 tickOffset {0.0f}; // Смещение за последний тик, нужно для интерполяции при отрисовке
 
 		float angle = 0.0f;
 		float targetAngle = 0.0f;
@@ -37,17 +53,25 @@ namespace hack_game {
 		const glm::vec3& getPos() const noexcept override {
 			return pos;
 		}
+
+		glm::vec3 getHitboxCenter() const noexcept override {
+			return pos;
+		}
 		
 		const Camera& getCamera() const noexcept {
 			return camera;
 		}
 
+		glm::vec3 getTickOffset() const noexcept override {
+			return tickOffset;
+		}
+
 		GLuint getShaderProgram() const noexcept override;
 		std::shared_ptr<const Player> shared_from_this() const;
 		
-		void updateKeys();
+		void setInput(const PlayerInput&);
 		void tick(Level&) override;
-		void draw() const override;
+		void draw(DrawList&) const override;
 		bool hasCollision(const glm::vec3&) const override;
 		void damage(Level&, hp_t) override;
 			
@@ -58,6 +82,16 @@ namespace hack_game {
 		void updateAngle(float targetAngle);
 		void move(Level&);
 	};
+
+
+	/**
+	 * @brief Разрешает коллизию игрока с врагом. Если игрок после смещения оказывается внутри врага,
+	 * смещение обрезается до точки пересечения с окружностью вокруг врага
+	 * @param pos позиция игрока на плоскости
+	 * @param offset смещение игрока
+	 * @return Новое смещение
+	 */
+	glm::vec2 resolveEnemyCollision(const Level& level, const glm::vec2& pos, glm::vec2 offset);
 }
 
 #endif
@@ -1,6 +1,7 @@
 #include "simple_entity.h"
 #include "model/model.h"
 #include "shader/shader.h"
+#include "render/draw_list.h"
 
 #include <glm/gtc/type_ptr.hpp>
 
@@ -9,9 +10,8 @@ namespace hack_game {
 		return shader.getId();
 	}
 
-	void SimpleEntity::draw() const {
-		shader.setModel(getModelTransform());
-		model.draw(shader);
+	void SimpleEntity::draw(DrawList& drawList) const {
+		drawList.add(shader, model, getModelTransform()).tickOffset = getTickOffset();
 	}
 
 	glm::mat4 SimpleEntity::getModelTransform() const {
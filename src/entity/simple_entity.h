@@ -20,7 +20,7 @@ namespace hack_game {
 
 		GLuint getShaderProgram() const noexcept override;
 		void tick(Level&) override {}
-		void draw() const override;
+		void draw(DrawList&) const override;
 
 		/// @return Матрицу трансформации модели. По умолчанию возвращает матрицу, которая никак не изменяет модель.
 		virtual glm::mat4 getModelTransform() const;
@@ -7,6 +7,8 @@ namespace hack_game {
 	using GLint = int32_t; // Полностью совместим с GLint из <GL/glew.h>
 	using GLuint = uint32_t; // Полностью совместим с GLuint из <GL/glew.h>
 	using GLenum = uint32_t; // Полностью совместим с GLenum из <GL/glew.h>
+	using GLsizei = int32_t; // Полностью совместим с GLsizei из <GL/glew.h>
+	using GLuint64 = uint64_t; // Полностью совместим с GLuint64 из <GL/glew.h>
 }
 
 #endif
@@ -4,7 +4,7 @@
 
 namespace hack_game {
 
-	#define POINTER_TEXTURE TEXTURES_DIR "pointer.png"
+	#define POINTER_TEXTURE TEXTURES_DIR "pointer.tex"
 
 	GuiContext::GuiContext():
 			pointerTextureId(Texture(POINTER_TEXTURE).genGlTexture()) {}
@@ -5,29 +5,20 @@
 
 namespace hack_game {
 
-	#define BG_TEXTURE TEXTURES_DIR "menu-bg.png"
+	#define BG_TEXTURE TEXTURES_DIR "menu-bg.tex"
 
 	static constexpr ImVec4 TEXT_COLOR = colorAsImVec4(0xFF'454232);
 	static constexpr float FADE_DURATION = 0.3f;
 
-	Menu::Menu(ShaderManager& shaderManager, size_t levelsCount) noexcept:
+	Menu::Menu(ShaderManager& shaderManager, size_t levelsCount, std::optional<uint64_t> levelSeed) noexcept:
 			FadingObject(FADE_DURATION, true),
 			shaderManager(shaderManager),
 			select(*this, levelsCount),
+			levelSeed(levelSeed),
 			bgTextureId(Texture(BG_TEXTURE).genGlTexture()) {}
 
-	std::shared_ptr<Player> Menu::getPlayer() const noexcept {
-		return level != nullptr ? level->getPlayer() : nullptr;
-	}
-
-	void Menu::setLevelDeltaTime(float deltaTime) noexcept {
-		if (level != nullptr) {
-			level->setDeltaTime(deltaTime);
-		}
-	}
-
 	void Menu::loadLevel(const std::string& path) {
-		level = std::make_shared<Level>(shaderManager, path);
+		level = std::make_shared<Level>(shaderManager, path, levelSeed);
 	}
 
 	bool Menu::draw(const GuiContext& context) {
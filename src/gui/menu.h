@@ -7,12 +7,12 @@
 #include "imgui_util.h"
 #include <string>
 #include <memory>
+#include <optional>
 
 namespace hack_game {
 
 	static constexpr ImVec2 NORMAL_WINDOW_SIZE = {1920, 1025};
 
-	class Player;
 	class Level;
 	class ShaderManager;
 
@@ -21,6 +21,7 @@ namespace hack_game {
 		MenuBottomPanel bottomPanel;
 		MenuSelect select;
 		std::shared_ptr<Level> level = nullptr;
+		const std::optional<uint64_t> levelSeed;
 		const GLuint bgTextureId;
 
 	public:
@@ -38,7 +39,8 @@ namespace hack_game {
 		static constexpr float STRIPE2_START = 7 + STRIPE1_END;
 		static constexpr float STRIPE2_END   = 3 + STRIPE2_START;
 
-		Menu(ShaderManager&, size_t levelsCount) noexcept;
+		/// @param levelSeed зерно генератора случайных чисел для всех загружаемых уровней (см. Level::Level)
+		Menu(ShaderManager&, size_t levelsCount, std::optional<uint64_t> levelSeed) noexcept;
 
 		float getFadeProgress() const noexcept {
 			return FadingObject::getFadeProgress();
@@ -52,9 +54,6 @@ namespace hack_game {
 			level.reset();
 		}
 
-		std::shared_ptr<Player> getPlayer() const noexcept;
-
-		void setLevelDeltaTime(float) noexcept;
 		void loadLevel(const std::string& path);
 		bool draw(const GuiContext&);
 	};
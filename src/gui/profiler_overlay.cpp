@@ -0,0 +1,167 @@
+#include "profiler_overlay.h"
+#include "render/render_snapshot.h"
+#include "render/gl_state.h"
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+
+namespace hack_game {
+
+	static constexpr float FONT_SCALE = 0.75f;
+	static constexpr float FPS_SHADOW_OFFSET = 1.5f;
+	static constexpr ImVec2 GRAPH_SIZE = {320, 60};
+
+	static constexpr ImU32 FPS_COLOR = colorAsImU32(0xFF'FFFFFF);
+	static constexpr ImU32 FPS_SHADOW_COLOR = colorAsImU32(0xFF'000000);
+
+	static constexpr ImGuiWindowFlags WINDOW_FLAGS =
+			ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+			ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav;
+
+	static constexpr const char* PASS_NAMES[gpu_timer::PASS_COUNT] = {
+		"opaque", "transparent", "imgui", "postprocessing"
+	};
+
+
+	void ProfilerOverlay::toggle() {
+		expanded = !expanded;
+
+		// Запросы времени ничего не стоят кадру, поэтому после первого включения остаются включёнными
+		if (expanded && !gpu_timer::isEnabled()) {
+			gpu_timer::enable(nullptr);
+		}
+	}
+
+	void ProfilerOverlay::addFrame(float deltaTime) noexcept {
+		frameTimes[nextFrame] = deltaTime * 1000.0f;
+		nextFrame = (nextFrame + 1) % HISTORY_SIZE;
+		frameCount = std::min(frameCount + 1, HISTORY_SIZE);
+	}
+
+	float ProfilerOverlay::getPercentile(float percentile) const noexcept {
+		if (frameCount == 0) {
+			return 0;
+		}
+
+		const size_t rank = static_cast<size_t>(std::ceil(percentile * frameCount));
+		return sortedTimes[std::clamp<size_t>(rank, 1, frameCount) - 1];
+	}
+
+
+	/// @brief Рисует FPS по медианному времени кадра. Тень рисуется одним смещённым текстом
+	static void drawFps(const GuiContext& context, float medianTime) {
+		char text[32];
+		std::snprintf(text, sizeof(text), "FPS: %d", medianTime > 0 ? static_cast<int>(std::lround(1000.0f / medianTime)) : 0);
+
+		const ImVec2 pos = ImGui::GetCursorScreenPos();
+		ImGui::GetWindowDrawList()->AddText(pos + context.scaleVec(FPS_SHADOW_OFFSET, FPS_SHADOW_OFFSET), FPS_SHADOW_COLOR, text);
+		ImGui::GetWindowDrawList()->AddText(pos, FPS_COLOR, text);
+		ImGui::Dummy(ImGui::CalcTextSize(text) + context.scaleVec(FPS_SHADOW_OFFSET, FPS_SHADOW_OFFSET));
+	}
+
+
+	void ProfilerOverlay::draw(const GuiContext& context, const FrameProfile& profile) {
+		// Пока история не заполнена, занята только её начальная часть
+		std::copy_n(frameTimes, frameCount, sortedTimes);
+		std::sort(sortedTimes, sortedTimes + frameCount);
+
+		ImGui::SetNextWindowPos(ImVec2(0, 0));
+		ImGui::Begin("ProfilerOverlay", nullptr, WINDOW_FLAGS | (expanded ? 0 : ImGuiWindowFlags_NoBackground));
+		ImGui::SetWindowFontScale(FONT_SCALE);
+
+		if (expanded) {
+			drawStats(context, profile, getPercentile(0.5f), getPercentile(0.95f), getPercentile(0.99f), getPercentile(1.0f));
+		} else {
+			drawFps(context, getPercentile(0.5f));
+		}
+
+		ImGui::End();
+	}
+
+
+	static void drawPasses(const FrameProfile& profile) {
+		if (!ImGui::BeginTable("Passes", 3, ImGuiTableFlags_SizingFixedFit)) {
+			return;
+		}
+
+		// Время на видеокарте приходит с задержкой в несколько кадров (см. gpu_timer)
+		const gpu_timer::FrameTimes& gpuTimes = gpu_timer::getLatest();
+
+		ImGui::TableSetupColumn("Pass");
+		ImGui::TableSetupColumn("CPU, ms");
+		ImGui::TableSetupColumn("GPU, ms");
+		ImGui::TableHeadersRow();
+
+		for (int pass = 0; pass < gpu_timer::PASS_COUNT; pass++) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(PASS_NAMES[pass]);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.2f", profile.cpuPasses[pass]);
+			ImGui::TableNextColumn();
+
+			if (gpuTimes.passes[pass] > 0) {
+				ImGui::Text("%.2f", gpuTimes.passes[pass] * 1e-6f);
+			} else {
+				ImGui::TextUnformatted("-");
+			}
+		}
+
+		ImGui::EndTable();
+	}
+
+
+	static void drawEntities(const RenderSnapshot& snapshot) {
+		size_t total = 0;
+
+		for (const EntityBucket& bucket : snapshot.entityBuckets) {
+			total += bucket.entities;
+		}
+
+		ImGui::Text("Entities: %zu", total);
+
+		if (!ImGui::BeginTable("Entities", 3, ImGuiTableFlags_SizingFixedFit)) {
+			return;
+		}
+
+		ImGui::TableSetupColumn("Pass");
+		ImGui::TableSetupColumn("Shader");
+		ImGui::TableSetupColumn("Count");
+		ImGui::TableHeadersRow();
+
+		for (const EntityBucket& bucket : snapshot.entityBuckets) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(bucket.pass == RenderPass::OPAQUE ? "opaque" : "transparent");
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", bucket.shader);
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", bucket.entities);
+		}
+
+		ImGui::EndTable();
+	}
+
+
+	void ProfilerOverlay::drawStats(const GuiContext& context, const FrameProfile& profile, float p50, float p95, float p99, float max) {
+		ImGui::Text("%.1f fps (p50), last %zu frames", p50 > 0 ? 1000.0f / p50 : 0.0f, frameCount);
+		ImGui::Text("p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms", p50, p95, p99, max);
+
+		// Самый старый кадр лежит на месте следующего, когда история заполнена
+		const int offset = frameCount == HISTORY_SIZE ? static_cast<int>(nextFrame) : 0;
+		ImGui::PlotLines("##FrameTimes", frameTimes, static_cast<int>(frameCount), offset, nullptr, 0.0f, max, context.scaleVec(GRAPH_SIZE));
+
+		ImGui::Separator();
+		drawPasses(profile);
+
+		const gl_state::FrameStats& glStats = gl_state::getFrameStats();
+		ImGui::Separator();
+		ImGui::Text("Draw calls: %zu", glStats.drawCalls);
+		ImGui::Text("GL state calls: %zu (%zu skipped)", glStats.calls, glStats.suppressed);
+
+		if (profile.snapshot != nullptr) {
+			ImGui::Separator();
+			drawEntities(*profile.snapshot);
+		}
+	}
+}
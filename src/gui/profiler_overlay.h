@@ -0,0 +1,52 @@
+#ifndef HACK_GAME__GUI__PROFILER_OVERLAY_H
+#define HACK_GAME__GUI__PROFILER_OVERLAY_H
+
+#include "gui_context.h"
+#include "render/gpu_timer.h"
+#include <cstddef>
+
+namespace hack_game {
+
+	struct RenderSnapshot;
+
+	/// Замеры текущего кадра, которые показывает ProfilerOverlay
+	struct FrameProfile {
+		float cpuPasses[gpu_timer::PASS_COUNT] {}; // Время каждого прохода на процессоре в миллисекундах
+		const RenderSnapshot* snapshot = nullptr;  // nullptr, если уровень не загружен
+	};
+
+	/**
+	 * @brief Счётчик FPS в углу экрана. Во включённом состоянии показывает график времени кадров,
+	 * перцентили времени за последние HISTORY_SIZE кадров, время проходов на процессоре и видеокарте,
+	 * количество сущностей по шейдерам и количество вызовов отрисовки.
+	 * История хранится в кольцевом буфере фиксированного размера, поэтому сам счётчик память не выделяет
+	 */
+	class ProfilerOverlay {
+	public:
+		static constexpr size_t HISTORY_SIZE = 240;
+
+	private:
+		float frameTimes[HISTORY_SIZE] {}; // В миллисекундах
+		float sortedTimes[HISTORY_SIZE] {};
+		size_t nextFrame = 0;
+		size_t frameCount = 0;
+		bool expanded = false;
+
+	public:
+		/// @brief Переключает между счётчиком FPS и полной статистикой. Полная статистика включает замеры gpu_timer
+		void toggle();
+
+		/// @brief Добавляет время кадра в историю
+		void addFrame(float deltaTime) noexcept;
+
+		void draw(const GuiContext&, const FrameProfile&);
+
+	private:
+		void drawStats(const GuiContext&, const FrameProfile&, float p50, float p95, float p99, float max);
+
+		/// @return Время кадра с перцентилем percentile (от 0 до 1) из отсортированной истории
+		float getPercentile(float percentile) const noexcept;
+	};
+}
+
+#endif
@@ -8,9 +8,15 @@
 #include "entity/minion.h"
 #include "entity/platform.h"
 #include "entity/walls.h"
+#include "entity/bullet.h"
+#include "entity/animation/minion_destroy.h"
+#include "entity/animation/enemy_damage.h"
+#include "trace.h"
+#include "util.h"
 
 // #include <boost/format.hpp>
 #include <fstream>
+#include <random>
 #include <nlohmann/json.hpp>
 
 namespace hack_game {
@@ -20,8 +26,9 @@ namespace hack_game {
 	using std::make_shared;
 	using std::ifstream;
 	using std::clamp;
+	using std::min;
+	using std::max;
 	using std::move;
-	using std::find;
 	using std::dynamic_pointer_cast;
 
 	using glm::uvec2;
@@ -58,7 +65,24 @@ namespace hack_game {
 
 	// ------------------------------------------- read -------------------------------------------
 
-	Level::Level(ShaderManager& shaderManager, const string& path) {
+	/// Столько короткоживущих сущностей помещается в пулы объектов. Контейнеры уровня сразу выделяются под них,
+	/// чтобы не расти, когда в бою впервые достигается новое количество сущностей
+	static constexpr size_t RESERVED_ENTITIES =
+			PlayerBullet::POOL_CAPACITY +
+			EnemyBullet::POOL_CAPACITY +
+			EnemyDamageAnimation::POOL_CAPACITY +
+			MinionDestroyAnimation::POOL_CAPACITY * (MinionDestroyAnimation::MAX_CUBES + 1);
+
+	static uint64_t randomSeed() {
+		std::random_device device;
+		return (uint64_t(device()) << 32) | device();
+	}
+
+
+	Level::Level(ShaderManager& shaderManager, const string& path, std::optional<uint64_t> seed):
+			path(path) {
+
+		TRACE_ZONE("loadLevel");
 		json object;
 
 		{
@@ -71,9 +95,26 @@ namespace hack_game {
 			file >> object;
 		}
 
+		if (!seed.has_value() && object.contains("seed")) {
+			seed = object["seed"].get<uint64_t>();
+		}
+
+		setSeed(seed.has_value() ? *seed : randomSeed());
+
 		readMap(shaderManager, path, object);
 		readEntities(shaderManager, path, object);
-		damageableEnemyEntities.push_back(enemy);
+		reserveEntities(shaderManager);
+	}
+
+
+	void Level::reserveEntities(ShaderManager& shaderManager) {
+		for (const auto& entry : shaderManager.getShadersById()) {
+			opaqueEntityMap[entry.first].reserve(RESERVED_ENTITIES);
+			transparentEntityMap[entry.first].reserve(RESERVED_ENTITIES);
+		}
+
+		addedEntities.reserve(RESERVED_ENTITIES);
+		removedEntities.reserve(RESERVED_ENTITIES);
 	}
 
 
@@ -93,6 +134,7 @@ namespace hack_game {
 		const size_t width = object["width"];
 		const size_t height = object["height"];
 		map.allocate(width, height);
+		damageableEnemyGrid.allocate(width, height);
 
 		const vector<string>& mapData = object["map"];
 
@@ -200,56 +242,104 @@ namespace hack_game {
 	}
 
 
-	static void addDamageable(const shared_ptr<Entity>& entity, vector<shared_ptr<Damageable>>& damageableEnemyEntities) {
-		auto damageable = dynamic_pointer_cast<Damageable>(entity);
+	static vec2 resolveBlockCollision(const Level& level, const vec2& pos, vec2 offset, const uvec2& mapPos) {
+		if (level.map[mapPos] == nullptr) {
+			return offset;
+		}
+
+		const AABB block = level.map[mapPos]->getHitbox();
+		const vec2 newPos = pos + offset;
+		
+		if (offset.x != 0 && block.containsInclusive(vec2(newPos.x, pos.y))) {
+			if (offset.x > 0) offset.x = max(0.0f, offset.x + (block.min.x - newPos.x - EPSILON));
+			else              offset.x = min(0.0f, offset.x + (block.max.x - newPos.x + EPSILON));
+		}
+
+		if (offset.y != 0 && block.containsInclusive(vec2(pos.x, newPos.y))) {
+			if (offset.y > 0) offset.y = max(0.0f, offset.y + (block.min.y - newPos.y - EPSILON));
+			else              offset.y = min(0.0f, offset.y + (block.max.y - newPos.y + EPSILON));
+		}
+
+		return offset;
+	}
+
+
+	vec2 resolveBlockCollision(const Level& level, const vec2& pos, vec2 offset) {
+		const vec2 newPos = pos + offset;
+		const uvec2 minPos = level.getMapPos(glm::min(pos, newPos) - EPSILON);
+		const uvec2 maxPos = level.getMapPos(glm::max(pos, newPos) + EPSILON);
+
+		offset = resolveBlockCollision(level, pos, offset, minPos);
+
+		if (minPos.x != maxPos.x) {
+			offset = resolveBlockCollision(level, pos, offset, uvec2(maxPos.x, minPos.y));
+		}
+
+		if (minPos.y != maxPos.y) {
+			offset = resolveBlockCollision(level, pos, offset, uvec2(minPos.x, maxPos.y));
+
+			if (minPos.x != maxPos.x) {
+				offset = resolveBlockCollision(level, pos, offset, maxPos);
+			}
+		}
+
+		return offset;
+	}
+
+
+	static void addDamageable(const shared_ptr<Entity>& entity, SpatialGrid& damageableEnemyGrid) {
+		Damageable* damageable = dynamic_cast<Damageable*>(entity.get());
 
 		if (damageable != nullptr && damageable->getSide() == Side::ENEMY && !damageable->invulnerable()) {
-			damageableEnemyEntities.push_back(move(damageable));
+			damageableEnemyGrid.add(damageable);
 		}
 	}
 
 
 	void Level::addEntityDirect(std::shared_ptr<Entity>&& entity) {
-		addDamageable(entity, damageableEnemyEntities);
-		getVector(entity).push_back(move(entity));
+		addDamageable(entity, damageableEnemyGrid);
+		insertEntity(move(entity));
 	}
 
 
 	void Level::addEntity(const shared_ptr<Entity>& entity) {
 		addedEntities.push_back(entity);
-		addDamageable(entity, damageableEnemyEntities);
+		addDamageable(entity, damageableEnemyGrid);
 	}
 
 
 	void Level::removeEntity(const shared_ptr<Entity>& entity) {
 		removedEntities.push_back(entity);
 
-		auto damageable = dynamic_pointer_cast<Damageable>(entity);
+		Damageable* damageable = dynamic_cast<Damageable*>(entity.get());
 
 		if (damageable != nullptr && damageable->getSide() == Side::ENEMY) {
-			auto it = find(damageableEnemyEntities.begin(), damageableEnemyEntities.end(), damageable);
-
-			if (it != damageableEnemyEntities.end()) {
-				damageableEnemyEntities.erase(it);
-			}
+			damageableEnemyGrid.remove(damageable);
 		}
 	}
 
 
-	Level::EntityVector& Level::getVector(const shared_ptr<Entity>& entity) noexcept {
+	void Level::moveDamageable(Damageable& damageable) {
+		damageableEnemyGrid.update(&damageable);
+	}
+
+
+	Level::EntitySlotMap& Level::getSlotMap(const shared_ptr<Entity>& entity) noexcept {
 		EntityMap& map = entity->isTransparent() ? transparentEntityMap : opaqueEntityMap;
 		return map[entity->getShaderProgram()];
 	}
 
+	void Level::insertEntity(shared_ptr<Entity>&& entity) {
+		Entity& ref = *entity;
+		ref.levelHandle = getSlotMap(entity).insert(move(entity));
+	}
+
 	void Level::updateEntities() {
+		TRACE_ZONE("updateEntities");
+
 		if (!removedEntities.empty()) {
 			for (const auto& entity : removedEntities) {
-				EntityVector& vector = getVector(entity);
-
-				const auto it = find(vector.cbegin(), vector.cend(), entity);
-				if (it != vector.cend()) {
-					vector.erase(it);
-				}
+				getSlotMap(entity).erase(entity->levelHandle);
 			}
 
 			removedEntities.clear();
@@ -257,7 +347,7 @@ namespace hack_game {
 
 		if (!addedEntities.empty()) {
 			for (auto& entity : addedEntities) {
-				getVector(entity).push_back(move(entity));
+				insertEntity(move(entity));
 			}
 
 			addedEntities.clear();
@@ -2,9 +2,14 @@
 #define HACK_GAME__LEVEL__LEVEL_H
 
 #include "gl_fwd.h"
+#include "spatial_grid.h"
+#include "slot_map.h"
+#include "random.h"
 #include <vector>
+#include <string>
 #include <map>
 #include <memory>
+#include <optional>
 
 #include <nlohmann/json_fwd.hpp>
 #include <glm/vec2.hpp>
@@ -62,7 +67,8 @@ namespace hack_game {
 		Map map;
 
 		using EntityVector = std::vector<std::shared_ptr<Entity>>;
-		using EntityMap = std::map<GLuint, EntityVector>;
+		using EntitySlotMap = SlotMap<std::shared_ptr<Entity>>;
+		using EntityMap = std::map<GLuint, EntitySlotMap>;
 
 	private:
 		std::shared_ptr<Player> player;
@@ -74,18 +80,48 @@ namespace hack_game {
 		EntityVector addedEntities;
 		EntityVector removedEntities;
 
-		std::vector<std::shared_ptr<Damageable>> damageableEnemyEntities;
+		SpatialGrid damageableEnemyGrid;
 
+		const std::string path;
 		float deltaTime = 0;
 
-		EntityVector& getVector(const std::shared_ptr<Entity>&) noexcept;
+		uint64_t seed;
+		Random random; // Используется только потоком, который выполняет тики
+
+		EntitySlotMap& getSlotMap(const std::shared_ptr<Entity>&) noexcept;
+		void insertEntity(std::shared_ptr<Entity>&&);
 		void addEntityDirect(std::shared_ptr<Entity>&&);
 
 		void readMap(ShaderManager& shaderManager, const std::string& path, const nlohmann::json&);
 		void readEntities(ShaderManager& shaderManager, const std::string& path, const nlohmann::json&);
 
+		/// @brief Создаёт контейнеры сущностей для всех шейдеров и выделяет в них память заранее
+		void reserveEntities(ShaderManager& shaderManager);
+
 	public:
-		Level(ShaderManager&, const std::string& path);
+		/**
+		 * @param seed зерно генератора случайных чисел. Если не задано, берётся из поля "seed" файла уровня,
+		 * а если его нет - случайное
+		 */
+		Level(ShaderManager&, const std::string& path, std::optional<uint64_t> seed = std::nullopt);
+
+		const std::string& getPath() const noexcept {
+			return path;
+		}
+
+		uint64_t getSeed() const noexcept {
+			return seed;
+		}
+
+		/// @brief Перезапускает генератор случайных чисел. Вызывается до первого тика
+		void setSeed(uint64_t seed) noexcept {
+			this->seed = seed;
+			random.setSeed(seed);
+		}
+
+		Random& getRandom() noexcept {
+			return random;
+		}
 
 		float getDeltaTime() const noexcept {
 			return deltaTime;
@@ -114,14 +150,28 @@ namespace hack_game {
 			return transparentEntityMap;
 		}
 
-		const std::vector<std::shared_ptr<Damageable>>& getDamageableEnemyEntities() const noexcept {
-			return damageableEnemyEntities;
+		/// @return Сетку уязвимых сущностей стороны Side::ENEMY
+		const SpatialGrid& getDamageableEnemyGrid() const noexcept {
+			return damageableEnemyGrid;
 		}
 
 		void addEntity(const std::shared_ptr<Entity>&);
 		void removeEntity(const std::shared_ptr<Entity>&);
+
+		/// @brief Обновляет положение сущности в сетке. Должен вызываться после каждого перемещения сущности Damageable
+		void moveDamageable(Damageable&);
 		void updateEntities();
 	};
+
+
+	/**
+	 * @brief Разрешает коллизию точки с блоками на карте
+	 * @param level уровень для получения блока
+	 * @param pos позиция точки на плоскости
+	 * @param offset смещение точки
+	 * @return Новое смещение
+	 */
+	glm::vec2 resolveBlockCollision(const Level& level, const glm::vec2& pos, glm::vec2 offset);
 }
 
 #endif
@@ -0,0 +1,135 @@
+#ifndef HACK_GAME__LEVEL__SLOT_MAP_H
+#define HACK_GAME__LEVEL__SLOT_MAP_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace hack_game {
+
+	/**
+	 * @brief Ссылка на элемент SlotMap. Остаётся безопасной после удаления элемента:
+	 * у слота меняется поколение, и старая ссылка перестаёт совпадать с ним
+	 */
+	struct SlotHandle {
+		static constexpr uint32_t INVALID_GENERATION = 0;
+
+		uint32_t index = 0;
+		uint32_t generation = INVALID_GENERATION;
+
+		constexpr bool isValid() const noexcept {
+			return generation != INVALID_GENERATION;
+		}
+
+		constexpr bool operator==(const SlotHandle&) const noexcept = default;
+	};
+
+
+	/**
+	 * @brief Контейнер с O(1) вставкой, удалением и поиском по SlotHandle.
+	 * Значения хранятся в непрерывном массиве, удаление переносит последний элемент на место удалённого,
+	 * поэтому порядок обхода не сохраняется. Итераторы инвалидируются при вставке и удалении.
+	 */
+	template<typename T>
+	class SlotMap {
+		struct Slot {
+			uint32_t denseIndex;
+			uint32_t generation;
+		};
+
+		std::vector<T> values;
+		std::vector<uint32_t> valueSlots; // Индекс слота для каждого значения
+		std::vector<Slot> slots;
+		std::vector<uint32_t> freeSlots;
+
+	public:
+		using iterator = typename std::vector<T>::iterator;
+		using const_iterator = typename std::vector<T>::const_iterator;
+
+		SlotHandle insert(T&& value) {
+			uint32_t slotIndex;
+
+			if (freeSlots.empty()) {
+				slotIndex = static_cast<uint32_t>(slots.size());
+				slots.push_back(Slot { 0, SlotHandle::INVALID_GENERATION + 1 });
+			} else {
+				slotIndex = freeSlots.back();
+				freeSlots.pop_back();
+			}
+
+			Slot& slot = slots[slotIndex];
+			slot.denseIndex = static_cast<uint32_t>(values.size());
+
+			values.push_back(std::move(value));
+			valueSlots.push_back(slotIndex);
+
+			return SlotHandle { slotIndex, slot.generation };
+		}
+
+		/// @brief Выделяет память под count элементов, чтобы вставка до этого количества не выделяла память
+		void reserve(size_t count) {
+			values.reserve(count);
+			valueSlots.reserve(count);
+			slots.reserve(count);
+			freeSlots.reserve(count);
+		}
+
+		/// @brief Удаляет элемент. Ничего не делает, если элемент уже удалён
+		/// @return true, если элемент был удалён
+		bool erase(const SlotHandle& handle) {
+			if (!contains(handle)) {
+				return false;
+			}
+
+			Slot& slot = slots[handle.index];
+			const uint32_t denseIndex = slot.denseIndex;
+			const uint32_t lastIndex = static_cast<uint32_t>(values.size() - 1);
+
+			if (denseIndex != lastIndex) {
+				values[denseIndex] = std::move(values[lastIndex]);
+				valueSlots[denseIndex] = valueSlots[lastIndex];
+				slots[valueSlots[denseIndex]].denseIndex = denseIndex;
+			}
+
+			values.pop_back();
+			valueSlots.pop_back();
+
+			// Поколение 0 зарезервировано для недействительных ссылок
+			if (++slot.generation == SlotHandle::INVALID_GENERATION) {
+				slot.generation += 1;
+			}
+
+			freeSlots.push_back(handle.index);
+			return true;
+		}
+
+		bool contains(const SlotHandle& handle) const noexcept {
+			return handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+		}
+
+		/// @return Указатель на элемент или nullptr, если элемент удалён
+		T* get(const SlotHandle& handle) noexcept {
+			return contains(handle) ? &values[slots[handle.index].denseIndex] : nullptr;
+		}
+
+		const T* get(const SlotHandle& handle) const noexcept {
+			return contains(handle) ? &values[slots[handle.index].denseIndex] : nullptr;
+		}
+
+		size_t size() const noexcept {
+			return values.size();
+		}
+
+		bool empty() const noexcept {
+			return values.empty();
+		}
+
+		iterator begin() noexcept { return values.begin(); }
+		iterator end()   noexcept { return values.end(); }
+
+		const_iterator begin() const noexcept { return values.begin(); }
+		const_iterator end()   const noexcept { return values.end(); }
+	};
+}
+
+#endif
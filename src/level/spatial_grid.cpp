@@ -0,0 +1,113 @@
+#include "spatial_grid.h"
+#include "level.h"
+#include "entity/damageable.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace hack_game {
+	using std::min;
+	using std::max;
+	using std::clamp;
+
+	using glm::uvec2;
+	using glm::vec3;
+
+
+	void SpatialGrid::allocate(size_t width, size_t height) {
+		assert(width > 0 && height > 0);
+
+		this->width = width;
+		this->height = height;
+		for (const cell_t& cell : cells) {
+			for (Damageable* damageable : cell) {
+				damageable->gridCell = Damageable::NO_GRID_CELL;
+			}
+		}
+
+		cells.assign(width * height, cell_t());
+		count = 0;
+	}
+
+
+	uvec2 SpatialGrid::getCellPos(const vec3& pos) const noexcept {
+		return uvec2(
+			clamp(pos.x * (1.0f / TILE_SIZE), 0.0f, float(width - 1)),
+			clamp(pos.z * (1.0f / TILE_SIZE), 0.0f, float(height - 1))
+		);
+	}
+
+	size_t SpatialGrid::getCellIndex(const vec3& pos) const noexcept {
+		const uvec2 cellPos = getCellPos(pos);
+		return cellPos.y * width + cellPos.x;
+	}
+
+	void SpatialGrid::addToCell(Damageable* damageable, size_t cellIndex) {
+		cell_t& cell = cells[cellIndex];
+		damageable->gridCell = cellIndex;
+		damageable->gridSlot = cell.size();
+		cell.push_back(damageable);
+	}
+
+	void SpatialGrid::removeFromCell(Damageable* damageable) noexcept {
+		cell_t& cell = cells[damageable->gridCell];
+		assert(damageable->gridSlot < cell.size() && cell[damageable->gridSlot] == damageable);
+
+		// Порядок в ячейке не важен, поэтому на место удалённой сущности переносится последняя
+		Damageable* const last = cell.back();
+		cell[damageable->gridSlot] = last;
+		last->gridSlot = damageable->gridSlot;
+		cell.pop_back();
+
+		damageable->gridCell = Damageable::NO_GRID_CELL;
+	}
+
+
+	void SpatialGrid::add(Damageable* damageable) {
+		if (damageable->gridCell != Damageable::NO_GRID_CELL) return;
+
+		addToCell(damageable, getCellIndex(damageable->getHitboxCenter()));
+		count += 1;
+	}
+
+	void SpatialGrid::remove(Damageable* damageable) noexcept {
+		if (damageable->gridCell == Damageable::NO_GRID_CELL) return;
+
+		removeFromCell(damageable);
+		count -= 1;
+	}
+
+	void SpatialGrid::update(Damageable* damageable) {
+		if (damageable->gridCell == Damageable::NO_GRID_CELL) return;
+
+		const size_t newIndex = getCellIndex(damageable->getHitboxCenter());
+		if (damageable->gridCell == newIndex) return;
+
+		removeFromCell(damageable);
+		addToCell(damageable, newIndex);
+	}
+
+
+	Damageable* SpatialGrid::findCollision(const vec3& point) const {
+		if (count == 0) {
+			return nullptr;
+		}
+
+		const uvec2 center = getCellPos(point);
+
+		const uvec2 start(center.x > 0 ? center.x - 1 : 0, center.y > 0 ? center.y - 1 : 0);
+		const uvec2 end(min<size_t>(center.x + 1, width - 1), min<size_t>(center.y + 1, height - 1));
+
+		for (size_t y = start.y; y <= end.y; y++) {
+			for (size_t x = start.x; x <= end.x; x++) {
+				for (Damageable* damageable : cells[y * width + x]) {
+					if (!damageable->destroyed() && damageable->hasCollision(point)) {
+						return damageable;
+					}
+				}
+			}
+		}
+
+		return nullptr;
+	}
+}
@@ -0,0 +1,62 @@
+#ifndef HACK_GAME__LEVEL__SPATIAL_GRID_H
+#define HACK_GAME__LEVEL__SPATIAL_GRID_H
+
+#include <vector>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+namespace hack_game {
+
+	class Damageable;
+
+	/**
+	 * @brief Равномерная сетка для быстрого поиска сущностей Damageable по позиции.
+	 * Размер ячейки равен TILE_SIZE, размер сетки совпадает с размером карты. Сущности за пределами карты
+	 * попадают в крайние ячейки. Каждая сущность хранится в ячейке центра своего хитбокса (Damageable::getHitboxCenter),
+	 * поэтому хитбокс не должен выходить за пределы TILE_SIZE от центра по осям x и z.
+	 * Сетка не владеет сущностями: сущность должна быть удалена из сетки до её уничтожения.
+	 * Ячейка и место в ней хранятся в самой сущности, поэтому сущность может быть только в одной сетке,
+	 * а добавление и удаление не выделяют память, когда ячейки уже достигли нужной ёмкости
+	 */
+	class SpatialGrid {
+		using cell_t = std::vector<Damageable*>;
+
+		size_t width = 0;
+		size_t height = 0;
+		std::vector<cell_t> cells;
+		size_t count = 0;
+
+		size_t getCellIndex(const glm::vec3& pos) const noexcept;
+		glm::uvec2 getCellPos(const glm::vec3& pos) const noexcept;
+		void addToCell(Damageable*, size_t cellIndex);
+		void removeFromCell(Damageable*) noexcept;
+
+	public:
+		SpatialGrid() noexcept = default;
+
+		void allocate(size_t width, size_t height);
+
+		/// @brief Добавляет сущность в сетку. Ничего не делает, если сущность уже в сетке
+		void add(Damageable*);
+
+		/// @brief Удаляет сущность из сетки. Ничего не делает, если сущности нет в сетке
+		void remove(Damageable*) noexcept;
+
+		/// @brief Переносит сущность в ячейку её текущей позиции. Должен вызываться после каждого перемещения.
+		/// Ничего не делает, если сущности нет в сетке
+		void update(Damageable*);
+
+		/// @return Количество сущностей в сетке
+		size_t size() const noexcept {
+			return count;
+		}
+
+		/**
+		 * @brief Ищет неуничтоженную сущность, у которой есть коллизия с точкой. Проверяет только ячейку точки и соседние с ней
+		 * @return Найденную сущность или nullptr
+		 */
+		Damageable* findCollision(const glm::vec3& point) const;
+	};
+}
+
+#endif
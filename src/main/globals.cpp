@@ -1,7 +1,7 @@
 #include "globals.h"
 
 namespace hack_game {
-	bool enemyDestroyed = false;
-	bool playerDestroyed = false;
-	int destroyAnimationCount = 0;
-}
\ No newline at end of file
+	std::atomic<bool> enemyDestroyed = false;
+	std::atomic<bool> playerDestroyed = false;
+	std::atomic<int> destroyAnimationCount = 0;
+}
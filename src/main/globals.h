@@ -1,17 +1,20 @@
 #ifndef HACK_GAME__MAIN__GLOBALS_H
 #define HACK_GAME__MAIN__GLOBALS_H
 
+#include <atomic>
+
 namespace hack_game {
-	
-	extern bool enemyDestroyed, playerDestroyed;
+
+	/// Изменяются в потоке симуляции, читаются и сбрасываются в потоке OpenGL
+	extern std::atomic<bool> enemyDestroyed, playerDestroyed;
 
 	/// Количество анимаций уничтожения Player и Enemy.
 	/// Пока оно больше 0, экран конца игры не показывается
-	extern int destroyAnimationCount;
+	extern std::atomic<int> destroyAnimationCount;
 
 	inline bool gameEnded() {
 		return (playerDestroyed || enemyDestroyed) && destroyAnimationCount == 0;
 	}
 }
 
-#endif
\ No newline at end of file
+#endif
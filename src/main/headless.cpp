@@ -0,0 +1,118 @@
+#include "headless.h"
+#include "simulation.h"
+#include "globals.h"
+#include "input_recording.h"
+#include "level/level.h"
+#include "entity/player.h"
+#include "memory/alloc_counter.h"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <limits>
+
+namespace hack_game {
+	using std::cout;
+	using std::endl;
+	using std::min;
+	using std::max;
+	using std::ofstream;
+
+	using clock = std::chrono::steady_clock;
+	using std::chrono::duration;
+
+
+	static size_t countEntities(const Level::EntityMap& entityMap) {
+		size_t count = 0;
+
+		for (const auto& entry : entityMap) {
+			count += entry.second.size();
+		}
+
+		return count;
+	}
+
+
+	void headlessLoop(ShaderManager& shaderManager, const std::string& levelPath, int ticks, float deltaTime, InputRecording* recording, std::optional<uint64_t> seed, bool profile) {
+		Level level(shaderManager, levelPath, seed);
+		level.setDeltaTime(deltaTime);
+
+		if (recording != nullptr) {
+			recording->beginLevel(level);
+		}
+
+		ofstream ticksFile;
+
+		if (profile) {
+			ticksFile.open("/tmp/ticks.log");
+			ticksFile << std::fixed << std::setprecision(2);
+		}
+
+		double totalTime = 0;
+		double minTime = std::numeric_limits<double>::infinity();
+		double maxTime = 0;
+		size_t maxEntities = 0;
+		int tickCount = 0;
+
+		// Первая половина тиков считается прогревом: в ней векторы и пулы достигают нужного размера
+		const size_t poolOverflowsBefore = getPoolOverflowCount();
+		size_t warmUpAllocations = 0;
+		size_t steadyAllocations = 0;
+
+		for (; tickCount < ticks && !gameEnded(); tickCount++) {
+			PlayerInput input;
+
+			if (recording != nullptr && !recording->nextTick(input)) {
+				break;
+			}
+
+			const size_t allocationsBefore = getThreadHeapAllocationCount();
+			const clock::time_point start = clock::now();
+			level.getPlayer()->setInput(input);
+			tick(level);
+			const double time = duration<double, std::micro>(clock::now() - start).count();
+
+			const size_t allocations = getThreadHeapAllocationCount() - allocationsBefore;
+			(tickCount < ticks / 2 ? warmUpAllocations : steadyAllocations) += allocations;
+
+			totalTime += time;
+			minTime = min(minTime, time);
+			maxTime = max(maxTime, time);
+
+			maxEntities = max(maxEntities, countEntities(level.getOpaqueEntityMap()) + countEntities(level.getTransparentEntityMap()));
+
+			if (profile) {
+				ticksFile << time << " us";
+
+				if (isHeapAllocationCountEnabled()) {
+					ticksFile << ", " << allocations << " allocs";
+				}
+
+				ticksFile << '\n';
+			}
+		}
+
+		cout << std::fixed << std::setprecision(2)
+			 << "Ticks:        " << tickCount << '\n'
+			 << "Max entities: " << maxEntities << '\n';
+
+		if (tickCount > 0) {
+			cout << "Total time:   " << totalTime / 1000 << " ms\n"
+				 << "Avg tick:     " << totalTime / tickCount << " us\n"
+				 << "Min tick:     " << minTime << " us\n"
+				 << "Max tick:     " << maxTime << " us\n";
+
+			if (isHeapAllocationCountEnabled()) {
+				cout << "Allocations:  " << warmUpAllocations << " (warm-up), " << steadyAllocations << " (steady)\n";
+			} else {
+				cout << "Allocations:  not counted (build with -DCOUNT_ALLOCATIONS=ON)\n";
+			}
+
+			cout << "Pool misses:  " << getPoolOverflowCount() - poolOverflowsBefore << '\n';
+		}
+
+		cout.flush();
+	}
+}
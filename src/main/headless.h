@@ -0,0 +1,26 @@
+#ifndef HACK_GAME__MAIN__HEADLESS_H
+#define HACK_GAME__MAIN__HEADLESS_H
+
+#include <string>
+#include <optional>
+#include <cstdint>
+
+namespace hack_game {
+	class ShaderManager;
+	class InputRecording;
+
+	/**
+	 * @brief Запускает симуляцию уровня без окна, GLFW, GLEW и контекста OpenGL.
+	 * Выполняет только tick(Level&) и выводит статистику времени тиков в stdout.
+	 * @param shaderManager менеджер с пустыми шейдерами (id = 0)
+	 * @param levelPath путь к файлу уровня
+	 * @param ticks максимальное количество тиков. Симуляция останавливается раньше, если игра закончилась
+	 * @param deltaTime время одного тика в секундах
+	 * @param recording запись управления или nullptr. Воспроизведение останавливается, когда запись закончится
+	 * @param seed зерно генератора случайных чисел уровня (см. Level::Level)
+	 * @param profile если true, то время каждого тика записывается в /tmp/ticks.log
+	 */
+	void headlessLoop(ShaderManager& shaderManager, const std::string& levelPath, int ticks, float deltaTime, InputRecording* recording, std::optional<uint64_t> seed, bool profile);
+}
+
+#endif
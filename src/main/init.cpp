@@ -7,6 +7,7 @@
 #include "entity/enemy.h"
 #include "entity/block.h"
 #include "entity/minion.h"
+#include "render/gl_state.h"
 
 #include <iostream>
 
@@ -183,13 +184,13 @@ namespace hack_game {
 		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
 
 		glGenTextures(1, &texture);
-		glBindTexture(GL_TEXTURE_2D, texture);
+		gl_state::bindTexture(0, texture);
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, windowWidth, windowHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		gl_state::bindTexture(0, 0);
 		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
 
 		assert(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
@@ -205,13 +206,13 @@ namespace hack_game {
 		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
 
 		glGenTextures(1, &texture);
-		glBindTexture(GL_TEXTURE_2D, texture);
+		gl_state::bindTexture(0, texture);
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, windowWidth, windowHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		gl_state::bindTexture(0, 0);
 		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
 
 		assert(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
@@ -220,11 +221,7 @@ namespace hack_game {
 
 
 	static FramebufferInfo initGL(GLFWwindow* window, GLint windowWidth, GLint windowHeight) {
-		for (Model* model : Model::getModels()) {
-			model->generateVertexArray();
-		}
-
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		gl_state::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 		
 		GLint width, height;
 		glfwGetFramebufferSize(window, &width, &height);
@@ -256,13 +253,13 @@ namespace hack_game {
 		glRenderbufferStorageMultisample(GL_RENDERBUFFER, SAMPLES, GL_DEPTH_COMPONENT24, width, height);
 		glBindRenderbuffer(GL_RENDERBUFFER, 0);
 
-		glBindTexture(GL_TEXTURE_2D, fbInfo.sceneNoMsTexture);
+		gl_state::bindTexture(0, fbInfo.sceneNoMsTexture);
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		gl_state::bindTexture(0, 0);
 
-		glBindTexture(GL_TEXTURE_2D, fbInfo.imGuiTexture);
+		gl_state::bindTexture(0, fbInfo.imGuiTexture);
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		gl_state::bindTexture(0, 0);
 
 		onChangeWindowSize(width, height);
 	}
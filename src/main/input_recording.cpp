@@ -0,0 +1,150 @@
+#include "input_recording.h"
+#include "level/level.h"
+
+#include <fstream>
+#include <iomanip>
+#include <cstring>
+#include <stdexcept>
+
+namespace hack_game {
+	using std::string;
+	using std::to_string;
+	using std::ifstream;
+	using std::ofstream;
+
+	static constexpr const char* HEADER = "hack_game input recording 1";
+
+	// Одна строка на тик: клавиши W, S, A, D, огонь (F) или '.', если клавиша не нажата, и поворот
+	static constexpr const char KEY_CHARS[] = "WSADF";
+	static constexpr const char TURN_CHARS[] = "-ULDR"; // В порядке PlayerInput::Turn
+	static constexpr size_t TICK_LINE_SIZE = 6;
+
+	static constexpr size_t RESERVED_TICKS = 60 * 60 * 120; // Час игры при частоте по умолчанию, чтобы запись не выделяла память во время игры
+
+
+	InputRecording::InputRecording(float tickRate):
+			mode(Mode::RECORD), tickRate(tickRate) {}
+
+
+	static string readValue(ifstream& file, const string& path, const string& key) {
+		string line;
+		std::getline(file, line);
+
+		if (line.compare(0, key.size() + 1, key + ' ') != 0) {
+			throw std::invalid_argument("File '" + path + "': expected '" + key + "'");
+		}
+
+		return line.substr(key.size() + 1);
+	}
+
+	static PlayerInput parseTick(const string& line, const string& path, size_t tick) {
+		const char* const turn = line.size() == TICK_LINE_SIZE ? std::strchr(TURN_CHARS, line[5]) : nullptr;
+
+		if (turn == nullptr || *turn == '\0') {
+			throw std::invalid_argument("File '" + path + "', tick " + to_string(tick) + ": invalid line '" + line + "'");
+		}
+
+		PlayerInput input;
+		input.up    = line[0] == KEY_CHARS[0];
+		input.down  = line[1] == KEY_CHARS[1];
+		input.left  = line[2] == KEY_CHARS[2];
+		input.right = line[3] == KEY_CHARS[3];
+		input.fire  = line[4] == KEY_CHARS[4];
+		input.turn  = static_cast<PlayerInput::Turn>(turn - TURN_CHARS);
+		return input;
+	}
+
+	InputRecording::InputRecording(const string& path):
+			mode(Mode::REPLAY) {
+
+		ifstream file(path);
+
+		if (!file.is_open()) {
+			throw std::ios_base::failure("Cannot open file '" + path + "'");
+		}
+
+		string line;
+		std::getline(file, line);
+
+		if (line != HEADER) {
+			throw std::invalid_argument("File '" + path + "' is not an input recording");
+		}
+
+		const string seedValue     = readValue(file, path, "seed");
+		const string tickRateValue = readValue(file, path, "tick-rate");
+		levelPath                  = readValue(file, path, "level");
+		const string ticksValue    = readValue(file, path, "ticks");
+
+		try {
+			seed     = std::stoull(seedValue);
+			tickRate = std::stof(tickRateValue);
+			inputs.resize(std::stoul(ticksValue));
+		} catch (const std::logic_error&) { // std::invalid_argument и std::out_of_range
+			throw std::invalid_argument("File '" + path + "': invalid header");
+		}
+
+		for (size_t tick = 0; tick < inputs.size(); tick++) {
+			if (!std::getline(file, line)) {
+				throw std::invalid_argument("File '" + path + "': expected " + to_string(inputs.size()) + " ticks, found " + to_string(tick));
+			}
+
+			inputs[tick] = parseTick(line, path, tick);
+		}
+	}
+
+
+	void InputRecording::beginLevel(Level& level) {
+		if (mode == Mode::REPLAY) {
+			level.setSeed(seed);
+			return;
+		}
+
+		seed = level.getSeed();
+		levelPath = level.getPath();
+		inputs.clear();
+		inputs.reserve(RESERVED_TICKS);
+	}
+
+	bool InputRecording::nextTick(PlayerInput& input) {
+		if (mode == Mode::RECORD) {
+			inputs.push_back(input);
+			return true;
+		}
+
+		if (nextInput >= inputs.size()) {
+			input = PlayerInput();
+			return false;
+		}
+
+		input = inputs[nextInput++];
+		return true;
+	}
+
+
+	void InputRecording::save(const string& path) const {
+		ofstream file(path);
+
+		file << HEADER << '\n'
+			 << "seed " << seed << '\n'
+			 << "tick-rate " << std::setprecision(9) << tickRate << '\n'
+			 << "level " << levelPath << '\n'
+			 << "ticks " << inputs.size() << '\n';
+
+		char line[TICK_LINE_SIZE + 2] {};
+		line[TICK_LINE_SIZE] = '\n';
+
+		for (const PlayerInput& input : inputs) {
+			line[0] = input.up    ? KEY_CHARS[0] : '.';
+			line[1] = input.down  ? KEY_CHARS[1] : '.';
+			line[2] = input.left  ? KEY_CHARS[2] : '.';
+			line[3] = input.right ? KEY_CHARS[3] : '.';
+			line[4] = input.fire  ? KEY_CHARS[4] : '.';
+			line[5] = TURN_CHARS[static_cast<size_t>(input.turn)];
+			file << line;
+		}
+
+		if (!file.good()) {
+			throw std::ios_base::failure("Cannot write file '" + path + "'");
+		}
+	}
+}
@@ -0,0 +1,81 @@
+#ifndef HACK_GAME__MAIN__INPUT_RECORDING_H
+#define HACK_GAME__MAIN__INPUT_RECORDING_H
+
+#include "entity/player.h"
+#include <string>
+#include <vector>
+
+namespace hack_game {
+
+	class Level;
+
+	/**
+	 * @brief Управление игроком по тикам одного уровня вместе с зерном генератора уровня и частотой тиков.
+	 * Симуляция не зависит от времени кадров, поэтому одна и та же запись на одном и том же уровне
+	 * даёт одинаковые тики. Используется для воспроизводимых замеров (--record и --replay).
+	 * Вызывается только из потока, который выполняет тики
+	 */
+	class InputRecording {
+	public:
+		enum class Mode: uint8_t {
+			RECORD, REPLAY
+		};
+
+	private:
+		const Mode mode;
+		uint64_t seed = 0;
+		float tickRate;
+		std::string levelPath;
+		std::vector<PlayerInput> inputs;
+		size_t nextInput = 0;
+
+	public:
+		/// @brief Создаёт пустую запись
+		explicit InputRecording(float tickRate);
+
+		/**
+		 * @brief Читает запись для воспроизведения
+		 * @throw std::ios_base::failure если файл не удалось открыть
+		 * @throw std::invalid_argument если файл содержит ошибку
+		 */
+		explicit InputRecording(const std::string& path);
+
+		Mode getMode() const noexcept {
+			return mode;
+		}
+
+		uint64_t getSeed() const noexcept {
+			return seed;
+		}
+
+		float getTickRate() const noexcept {
+			return tickRate;
+		}
+
+		const std::string& getLevelPath() const noexcept {
+			return levelPath;
+		}
+
+		size_t getTickCount() const noexcept {
+			return inputs.size();
+		}
+
+		/**
+		 * @brief Вызывается перед первым тиком уровня. При записи запоминает уровень и его зерно и отбрасывает
+		 * тики предыдущего уровня, так что в файл попадает последний начатый уровень.
+		 * При воспроизведении перезапускает генератор уровня с зерном записи
+		 */
+		void beginLevel(Level&);
+
+		/**
+		 * @brief При записи добавляет input в запись, при воспроизведении заменяет его следующим тиком записи
+		 * @return false, если записанные тики закончились. input при этом становится пустым
+		 */
+		bool nextTick(PlayerInput& input);
+
+		/// @throw std::ios_base::failure если файл не удалось записать
+		void save(const std::string& path) const;
+	};
+}
+
+#endif
@@ -1,11 +1,17 @@
 #include "main.h"
 #include "init.h"
 #include "render.h"
+#include "simulation.h"
+#include "input_recording.h"
 #include "shader/shader_manager.h"
 #include "entity/player.h"
 #include "gui/menu.h"
+#include "render/gpu_timer.h"
+#include "trace.h"
+#include "dir_paths.h"
 
 #include <fstream>
+#include <filesystem>
 #include <iomanip>
 #include <thread>
 #include <chrono>
@@ -17,78 +23,122 @@
 namespace hack_game {
 
 	using std::unique_ptr;
-	using std::shared_ptr;
 	using std::ostream;
 	using std::ofstream;
 
 	static volatile bool paused = false;
 	static volatile bool nextFrame = false;
 
-	static void updateKeys(const RenderContext& renderContext, const shared_ptr<Player>& player);
+	static void updateKeys(const RenderContext& renderContext, Simulation& simulation);
 	static void renderEmptyImGui();
 
-	static void tick(Level& level, const Level::EntityMap& entityMap);
-	static void tick(Level& level);
-
 
 	/// @brief Главный цикл всей игры. Этапы:
-	/// 1. Обновление клавиш
-	/// 2. Обновление состояния всех сущностей (в том числе просчёт коллизий)
-	/// 3. Отрисовка сцены и GUI
-	/// При паузе обновляет только состояние клавиш
-	void mainLoop(const RenderContext& renderContext, ShaderManager& shaderManager, bool profile) {
-		static Menu menu(shaderManager, 48);
+	/// 1. Обновление клавиш и передача их потоку симуляции
+	/// 2. Передача текущего уровня потоку симуляции. Сами тики (в том числе просчёт коллизий)
+	///    выполняются в отдельном потоке с фиксированным шагом (см. Simulation)
+	/// 3. Отрисовка последнего снимка сцены и GUI. Позиции сущностей интерполируются между двумя последними тиками
+	/// При паузе обновляет только состояние клавиш.
+	/// При воспроизведении записи сразу загружает её уровень и закрывает окно, когда запись закончится
+	void mainLoop(const RenderContext& renderContext, ShaderManager& shaderManager, const TickSettings& tickSettings, InputRecording* recording, std::optional<uint64_t> seed, bool profile) {
+		static Menu menu(shaderManager, 48, seed);
 
 		GLFWwindow* const window = renderContext.getWindow();
 
 		unique_ptr<ostream> fpsFile = nullptr;
+		unique_ptr<ostream> shadersTimeFile = nullptr; // Время шейдеров по кадрам, его читает show-shaders-time.py
 
 		if (profile) {
 			fpsFile = std::make_unique<ofstream>("/tmp/fps.log");
 			*fpsFile << std::fixed << std::setprecision(2) << std::setw(7);
+
+			std::error_code error;
+			std::filesystem::create_directories(DEBUG_DIR, error);
+
+			shadersTimeFile = std::make_unique<ofstream>(DEBUG_DIR "shaders-time.log");
+			gpu_timer::enable(shadersTimeFile.get());
 		}
 
 		const float waitTime = 1.0f / renderContext.getRefreshRate();
 
-		for (float lastFrame = 0; !glfwWindowShouldClose(window);) {
+		Simulation simulation(tickSettings, recording);
+
+		if (recording != nullptr && recording->getMode() == InputRecording::Mode::REPLAY) {
+			menu.loadLevel(recording->getLevelPath());
+		}
+
+		for (float lastFrame = glfwGetTime(); !glfwWindowShouldClose(window);) {
+			TRACE_ZONE("frame");
+
 			const float currentFrame = glfwGetTime();
 			const float deltaTime = currentFrame - lastFrame;
-			menu.setLevelDeltaTime(deltaTime);
 			lastFrame = currentFrame;
 
-			updateKeys(renderContext, menu.getPlayer());
+			updateKeys(renderContext, simulation);
+			simulation.setLevel(menu.getLevel());
 
-			if (menu.getLevel() != nullptr) {
-				tick(*menu.getLevel());
+			if (simulation.isReplayFinished()) {
+				glfwSetWindowShouldClose(window, GLFW_TRUE);
 			}
 
-			render(renderContext, shaderManager, menu, fpsFile, deltaTime);
-			glfwSwapBuffers(window);
+			render(renderContext, shaderManager, menu, simulation, fpsFile, deltaTime);
+
+			{
+				TRACE_ZONE("glfwSwapBuffers");
+				glfwSwapBuffers(window);
+			}
 
 			// check paused
 			if (paused) {
+				simulation.setPaused(true);
+
 				while (paused && !nextFrame && !glfwWindowShouldClose(window)) {
 					std::this_thread::sleep_for(std::chrono::nanoseconds(static_cast<uint64_t>(waitTime * (1e9f / 2))));
 
-					updateKeys(renderContext, menu.getPlayer());
+					updateKeys(renderContext, simulation);
 					renderEmptyImGui();
 				}
 
-				nextFrame = false;
-				lastFrame = glfwGetTime() - waitTime;
+				// Следующий кадр покажет результат ровно одного тика
+				if (nextFrame) {
+					simulation.step();
+					nextFrame = false;
+				}
+
+				simulation.setPaused(paused);
+				lastFrame = glfwGetTime();
 			}
 		}
 	}
 
 
-	static void updateKeys(const RenderContext& renderContext, const shared_ptr<Player>& player) {
+	/// @brief Считывает состояние клавиш управления игроком из текущего контекста ImGui
+	static PlayerInput readPlayerInput() {
+		using Turn = PlayerInput::Turn;
+
+		PlayerInput input;
+		input.up    = ImGui::IsKeyDown(ImGuiKey_W);
+		input.left  = ImGui::IsKeyDown(ImGuiKey_A);
+		input.down  = ImGui::IsKeyDown(ImGuiKey_S);
+		input.right = ImGui::IsKeyDown(ImGuiKey_D);
+		input.fire  = ImGui::IsKeyDown(ImGuiKey_LeftShift);
+
+		if (ImGui::IsKeyPressed(ImGuiKey_UpArrow, false))    input.turn = Turn::UP;
+		if (ImGui::IsKeyPressed(ImGuiKey_LeftArrow, false))  input.turn = Turn::LEFT;
+		if (ImGui::IsKeyPressed(ImGuiKey_DownArrow, false))  input.turn = Turn::DOWN;
+		if (ImGui::IsKeyPressed(ImGuiKey_RightArrow, false)) input.turn = Turn::RIGHT;
+
+		return input;
+	}
+
+	static void updateKeys(const RenderContext& renderContext, Simulation& simulation) {
+		TRACE_ZONE("updateKeys");
+
 		ImGui::SetCurrentContext(renderContext.getImGuiMainContext());
 		glfwPollEvents();
 		ImGui_ImplGlfw_NewFrame();
 
-		if (player != nullptr) {
-			player->updateKeys();
-		}
+		simulation.setInput(readPlayerInput());
 		
 		if (ImGui::IsKeyPressed(ImGuiKey_F1)) {
 			paused = !paused;
@@ -102,6 +152,14 @@ namespace hack_game {
 		if (ImGui::IsKeyPressed(ImGuiKey_F2) && paused) {
 			nextFrame = true;
 		}
+
+		if (ImGui::IsKeyPressed(ImGuiKey_F3) && trace::isEnabled()) {
+			trace::dump();
+		}
+
+		if (ImGui::IsKeyPressed(ImGuiKey_F4)) {
+			toggleProfilerOverlay();
+		}
 	}
 
 
@@ -111,20 +169,4 @@ namespace hack_game {
 		ImGui::Render();
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 	}
-
-
-	static void tick(Level& level, const Level::EntityMap& entityMap) {
-		for (auto& entry : entityMap) {
-			for (const auto& entity : entry.second) {
-				entity->tick(level);
-			}
-		}
-	}
-
-
-	static void tick(Level& level) {
-		tick(level, level.getOpaqueEntityMap());
-		tick(level, level.getTransparentEntityMap());
-		level.updateEntities();
-	}
 }
\ No newline at end of file
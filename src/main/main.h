@@ -2,10 +2,27 @@
 #define HACK_GAME__MAIN__MAIN_H
 
 #include "init.h"
+#include <optional>
+#include <cstdint>
 
 namespace hack_game {
 	class RenderContext;
-	void mainLoop(const RenderContext&, ShaderManager&, bool profile);
+	class InputRecording;
+
+	/// Параметры фиксированного шага симуляции
+	struct TickSettings {
+		float tickRate = 120.0f; /// Количество тиков в секунду
+		int maxCatchUpTicks = 8; /// На сколько тиков симуляция может отстать от реального времени. Если она отстаёт сильнее, лишнее время отбрасывается
+
+		/// @return Длительность одного тика в секундах
+		float getTickTime() const noexcept {
+			return 1.0f / tickRate;
+		}
+	};
+
+	/// @param recording запись управления для --record и --replay или nullptr
+	/// @param seed зерно генератора случайных чисел уровней из --seed
+	void mainLoop(const RenderContext&, ShaderManager&, const TickSettings&, InputRecording* recording, std::optional<uint64_t> seed, bool profile);
 }
 
 #endif
\ No newline at end of file
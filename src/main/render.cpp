@@ -1,11 +1,18 @@
 #include "render.h"
 #include "init.h"
 #include "globals.h"
+#include "simulation.h"
 #include "shader/shader_manager.h"
-#include "entity/player.h"
 #include "model/models.h"
 #include "gui/menu.h"
 #include "gui/win_screen.h"
+#include "gui/profiler_overlay.h"
+#include "render/gl_state.h"
+#include "render/gpu_timer.h"
+#include "memory/alloc_counter.h"
+#include "trace.h"
+
+#include <chrono>
 
 #define GLEW_STATIC
 #include <GL/glew.h>
@@ -22,21 +29,46 @@ namespace hack_game {
 	using std::ostream;
 	using std::unique_ptr;
 
+	using clock = std::chrono::steady_clock;
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+
 	static constexpr ImVec4 BACKGROUND = colorAsImVec4(0xFF'636155);
 	static constexpr float ENDGAME_DURATION = 1.0f;
-	static constexpr float FPS_STROKE_SIZE = 1.5f;
+
+	static ProfilerOverlay profilerOverlay;
+	static FrameProfile frameProfile;
+	static clock::time_point passStart;
 
 
-	static void renderScene(const RenderContext&, ShaderManager&, const Level&);
+	static void renderScene(const RenderContext&, ShaderManager&, const RenderSnapshot&, float tickProgress);
 	static void renderImGui(const RenderContext&, GuiContext&, Menu&, float winScreenTime);
 	static void renderPostprocess(const RenderContext&, const GuiContext&, ShaderManager&, Menu&, float winScreenTime);
+	static void writeFrameStats(ostream& fpsFile, const RenderSnapshot*, float deltaTime);
+
+
+	/// @brief Начинает замер прохода на процессоре и на видеокарте
+	static void beginProfiledPass(gpu_timer::Pass pass) {
+		gpu_timer::beginPass(pass);
+		passStart = clock::now();
+	}
+
+	static void endProfiledPass(gpu_timer::Pass pass) {
+		frameProfile.cpuPasses[pass] = Milliseconds(clock::now() - passStart).count();
+		gpu_timer::endPass(pass);
+	}
+
+	void toggleProfilerOverlay() {
+		profilerOverlay.toggle();
+	}
 
 
-	void render(const RenderContext& renderContext, ShaderManager& shaderManager, Menu& menu, const unique_ptr<ostream>& fpsFile, float deltaTime) {
+	void render(const RenderContext& renderContext, ShaderManager& shaderManager, Menu& menu, Simulation& simulation, const unique_ptr<ostream>& fpsFile, float deltaTime) {
 		static GuiContext guiContext;
 		static float endGameTime = 0;
 
 		guiContext.setDeltaTime(deltaTime);
+		gl_state::resetFrameStats();
+		profilerOverlay.addFrame(deltaTime);
 
 		if ((enemyDestroyed || playerDestroyed) && destroyAnimationCount == 0) {
 			endGameTime += deltaTime;
@@ -51,79 +83,102 @@ namespace hack_game {
 
 		const float winScreenTime = enemyDestroyed ? endGameTime : 0;
 
-		if (fpsFile == nullptr) {
-			if (menu.getLevel() != nullptr) {
-				renderScene(renderContext, shaderManager, *menu.getLevel().get());
-			}
-
-			renderImGui(renderContext, guiContext, menu, winScreenTime);
-			renderPostprocess(renderContext, guiContext, shaderManager, menu, winScreenTime);
+		const RenderSnapshot* snapshot = menu.getLevel() != nullptr ? simulation.getSnapshot() : nullptr;
 
-		} else {
-			if (menu.getLevel() != nullptr) {
-				const float startTime = glfwGetTime();
-				renderScene(renderContext, shaderManager, *menu.getLevel().get());
-				glFinish();
-				const float endTime = glfwGetTime();
+		gpu_timer::beginFrame();
+		frameProfile = FrameProfile();
+		frameProfile.snapshot = snapshot;
 
-				*fpsFile << (1.0f / (endTime  - startTime)) << " fps (render), ";
-			}
+		if (snapshot != nullptr) {
+			renderScene(renderContext, shaderManager, *snapshot, simulation.getTickProgress(*snapshot));
+		}
 
-			renderImGui(renderContext, guiContext, menu, winScreenTime);
+		beginProfiledPass(gpu_timer::IMGUI_PASS);
+		renderImGui(renderContext, guiContext, menu, winScreenTime);
+		endProfiledPass(gpu_timer::IMGUI_PASS);
 
-			const float startTime = glfwGetTime();
-			renderPostprocess(renderContext, guiContext, shaderManager, menu, winScreenTime);
-			glFinish();
-			const float endTime = glfwGetTime();
+		beginProfiledPass(gpu_timer::POSTPROCESSING_PASS);
+		renderPostprocess(renderContext, guiContext, shaderManager, menu, winScreenTime);
+		endProfiledPass(gpu_timer::POSTPROCESSING_PASS);
 
-			*fpsFile << (1.0f / (endTime - startTime)) << " fps (postprocessing)\n";
+		if (fpsFile != nullptr) {
+			writeFrameStats(*fpsFile, snapshot, deltaTime);
 		}
 	}
 
 
+	/// @return FPS, которого можно было бы достичь, если бы кадр занимал nanoseconds. 0, если проход не отрисовывался
+	static float toFps(GLuint64 nanoseconds) {
+		return nanoseconds > 0 ? 1e9f / nanoseconds : 0.0f;
+	}
 
-	static void renderEntities(ShaderManager& shaderManager, const Level& level, const Level::EntityMap& entityMap) {
-		for (auto& entry : entityMap) {
-			if (entry.second.empty()) continue;
-
-			const GLuint shaderId = entry.first;
+	static float toMilliseconds(GLuint64 nanoseconds) {
+		return nanoseconds * 1e-6f;
+	}
 
-			if (shaderId > 0) {
-				Shader& shader = shaderManager.getShader(shaderId);
-				shader.use();
-				shader.setView(level.getPlayer()->getCamera().getView());
+	/**
+	 * @brief Записывает строку статистики кадра. Первые три числа - FPS кадра, отрисовки сцены и постобработки,
+	 * их читает show-fps.py. Время на видеокарте берётся из последнего готового кадра (см. gpu_timer),
+	 * поэтому отстаёт на несколько кадров
+	 */
+	static void writeFrameStats(ostream& fpsFile, const RenderSnapshot* snapshot, float deltaTime) {
+		const gpu_timer::FrameTimes& gpuTimes = gpu_timer::getLatest();
+
+		const GLuint64 opaqueTime = gpuTimes.passes[gpu_timer::OPAQUE_PASS];
+		const GLuint64 transparentTime = gpuTimes.passes[gpu_timer::TRANSPARENT_PASS];
+
+		fpsFile << (1.0f / deltaTime) << " fps, "
+		        << toFps(opaqueTime + transparentTime) << " fps (render), "
+		        << toFps(gpuTimes.passes[gpu_timer::POSTPROCESSING_PASS]) << " fps (postprocessing), "
+		        << toMilliseconds(opaqueTime) << " ms (opaque), "
+		        << toMilliseconds(transparentTime) << " ms (transparent), "
+		        << toMilliseconds(gpuTimes.passes[gpu_timer::IMGUI_PASS]) << " ms (imgui)";
+
+		if (snapshot != nullptr) {
+			const gl_state::FrameStats& glStats = gl_state::getFrameStats();
+
+			if (isHeapAllocationCountEnabled()) {
+				fpsFile << ", " << snapshot->tickAllocations << " allocs/tick";
 			}
-			
 
-			for (const auto& entity : entry.second) {
-				entity->draw();
-			}
+			fpsFile << ", " << glStats.calls << " GL state calls (" << glStats.suppressed << " skipped)";
 		}
+
+		fpsFile << '\n';
 	}
 
 
-	static void renderScene(const RenderContext& renderContext, ShaderManager& shaderManager, const Level& level) {
+
+	static void renderScene(const RenderContext& renderContext, ShaderManager& shaderManager, const RenderSnapshot& snapshot, float tickProgress) {
+		TRACE_ZONE("renderScene");
+
 		ImGui::SetCurrentContext(renderContext.getImGuiMainContext());
 
 		glBindFramebuffer(GL_FRAMEBUFFER, renderContext.getFbInfo().sceneFramebuffer);
 		glClearColor(RGBA(BACKGROUND));
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-		glEnable(GL_DEPTH_TEST);
-		glEnable(GL_CULL_FACE);
-		glEnable(GL_MULTISAMPLE);
+		gl_state::setEnabled(GL_DEPTH_TEST, true);
+		gl_state::setEnabled(GL_CULL_FACE, true);
+		gl_state::setEnabled(GL_MULTISAMPLE, true);
 				
-		renderEntities(shaderManager, level, level.getOpaqueEntityMap());
+		shaderManager.setView(snapshot.getInterpolatedView(tickProgress));
+
+		beginProfiledPass(gpu_timer::OPAQUE_PASS);
+		snapshot.drawList.execute(RenderPass::OPAQUE, tickProgress);
+		endProfiledPass(gpu_timer::OPAQUE_PASS);
 
-		glDisable(GL_DEPTH_TEST);
-		glDepthMask(GL_FALSE);
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		gl_state::setEnabled(GL_DEPTH_TEST, false);
+		gl_state::setDepthMask(false);
+		gl_state::setEnabled(GL_BLEND, true);
+		gl_state::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-		renderEntities(shaderManager, level, level.getTransparentEntityMap());
+		beginProfiledPass(gpu_timer::TRANSPARENT_PASS);
+		snapshot.drawList.execute(RenderPass::TRANSPARENT, tickProgress);
+		endProfiledPass(gpu_timer::TRANSPARENT_PASS);
 
-		glEnable(GL_DEPTH_TEST);
-		glDepthMask(GL_TRUE);
-		glDisable(GL_BLEND);
+		gl_state::setEnabled(GL_DEPTH_TEST, true);
+		gl_state::setDepthMask(true);
+		gl_state::setEnabled(GL_BLEND, false);
 	}
 
 
@@ -146,6 +201,8 @@ namespace hack_game {
 
 
 	static void renderImGui(const RenderContext& renderContext, GuiContext& guiContext, Menu& menu, float winScreenTime) {
+		TRACE_ZONE("renderImGui");
+
 		static WinScreen winScreen;
 
 		ImGui::SetCurrentContext(renderContext.getImGuiMainContext());
@@ -173,46 +230,9 @@ namespace hack_game {
 	}
 
 
-	static void renderFPS(const GuiContext& context) {
-		static float timeSum = 0;
-		static int times = 0;
-		static int fps = 0;
-
-		timeSum += context.getDeltaTime();
-		times += 1;
-
-		if (timeSum >= 1) {
-			fps = static_cast<int>(times / timeSum);
-			timeSum = 0;
-			times = 0;
-		}
-		
-		const std::string text = "FPS: " + std::to_string(fps);
-
-		ImGui::SetNextWindowPos(ImVec2(0, 0));
-		ImGui::Begin("FpsWindow", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoBackground | ImGuiWindowFlags_AlwaysAutoResize);
-
-		ImGui::SetWindowFontScale(0.75f);
-
-		static constexpr ImVec2 STROKE_COORDS[] = {
-			{0, 0},
-			{0, FPS_STROKE_SIZE * 2},
-			{FPS_STROKE_SIZE * 2, 0},
-			{FPS_STROKE_SIZE * 2, FPS_STROKE_SIZE * 2}
-		};
-
-		for (const ImVec2& pos : STROKE_COORDS) {
-			ImGui::SetCursorPos(context.scaleVec(pos));
-			ImGui::TextColored(colorAsImVec4(0xFF'000000), "%s", text.c_str());
-		}
-
-		ImGui::SetCursorPos(context.scaleVec(FPS_STROKE_SIZE, FPS_STROKE_SIZE));
-		ImGui::TextColored(colorAsImVec4(0xFF'FFFFFF), "%s", text.c_str());
-		ImGui::End();
-	}
-
-
 	static void renderPostprocess(const RenderContext& renderContext, const GuiContext& guiContext, ShaderManager& shaderManager, Menu& menu, float winScreenTime) {
+		TRACE_ZONE("renderPostprocess");
+
 		const float windowWidth = renderContext.getWindowWidth();
 		const float windowHeight = renderContext.getWindowHeight();
 
@@ -221,31 +241,28 @@ namespace hack_game {
 		glBlitFramebuffer(0, 0, windowWidth, windowHeight, 0, 0, windowWidth, windowHeight, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
-		glDisable(GL_DEPTH_TEST);
-		glDisable(GL_CULL_FACE);
-		glDisable(GL_MULTISAMPLE);
+		gl_state::setEnabled(GL_DEPTH_TEST, false);
+		gl_state::setEnabled(GL_CULL_FACE, false);
+		gl_state::setEnabled(GL_MULTISAMPLE, false);
 
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, renderContext.getFbInfo().sceneNoMsTexture);
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, renderContext.getFbInfo().imGuiTexture);
+		gl_state::bindTexture(0, renderContext.getFbInfo().sceneNoMsTexture);
+		gl_state::bindTexture(1, renderContext.getFbInfo().imGuiTexture);
 
 		Shader& postprocessing = shaderManager.getShader("postprocessing");
 		postprocessing.use();
-		postprocessing.setUniform("winScreenTime", winScreenTime);
-		postprocessing.setUniform("guiFadeProgress", menu.getFadeProgress());
+		postprocessing.setUniform(uniform::winScreenTime, winScreenTime);
+		postprocessing.setUniform(uniform::guiFadeProgress, menu.getFadeProgress());
 		
 		models::postprocessingModel.draw(postprocessing);
 
-		glBindTexture(GL_TEXTURE_2D, 0);
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		gl_state::bindTexture(1, 0);
+		gl_state::bindTexture(0, 0);
 
 		ImGui::SetCurrentContext(renderContext.getImGuiFpsContext());
 		ImGui_ImplOpenGL3_NewFrame();
 		setImGuiSizeAndScale(renderContext.getWindow());
 		ImGui::NewFrame();
-		renderFPS(guiContext);
+		profilerOverlay.draw(guiContext, frameProfile);
 		ImGui::Render();
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 	}
@@ -9,8 +9,12 @@ namespace hack_game {
 	class RenderContext;
 	class ShaderManager;
 	class Menu;
+	class Simulation;
 
-	void render(const RenderContext&, ShaderManager&, Menu&, const std::unique_ptr<std::ostream>& fpsFile, float deltaTime);
+	void render(const RenderContext&, ShaderManager&, Menu&, Simulation&, const std::unique_ptr<std::ostream>& fpsFile, float deltaTime);
+
+	/// @brief Переключает счётчик FPS между кратким и подробным видом (см. ProfilerOverlay)
+	void toggleProfilerOverlay();
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,37 @@
+#include "shaders.h"
+#include "shader/shader_loader.h"
+
+namespace hack_game {
+
+	/// @brief Компилирует шейдер. В режиме --headless возвращает пустой шейдер без обращения к OpenGL
+	static Shader loadShader(bool headless, const char* name, const char* vertexShader, const char* fragmentShader) {
+		return headless ? Shader(name) : Shader(name, createShaderProgram(vertexShader, fragmentShader));
+	}
+
+	/// @brief Компилирует шейдер анимации. В режиме --headless возвращает пустой шейдер без обращения к OpenGL
+	static Shader loadAnimationShader(bool headless, const char* name, const char* vertexShader, const char* fragmentShader) {
+		return headless ? Shader(name) : Shader(name, createAnimationShaderProgram(vertexShader, fragmentShader));
+	}
+
+
+	ShaderManager createShaderManager(GLint windowWidth, GLint windowHeight, bool headless) {
+		return ShaderManager {
+			windowWidth,
+			windowHeight,
+			Shader("null"),
+			loadShader(headless, "main",           "main.vert",           "main.frag"),
+			loadShader(headless, "light",          "light.vert",          "light.frag"),
+			loadShader(headless, "lightInstanced", "light-instanced.vert", "light-instanced.frag"),
+			loadShader(headless, "postprocessing", "postprocessing.vert", "postprocessing.frag"),
+			loadAnimationShader(headless, "enemyDamage",            "animation.vert",          "enemy-damage.frag"),
+			loadAnimationShader(headless, "enemyDestroyFlat",       "animation.vert",          "enemy-destroy-flat.frag"),
+			loadAnimationShader(headless, "enemyDestroyBillboard",  "textured-animation.vert", "enemy-destroy-billboard.frag"),
+			loadAnimationShader(headless, "minionDestroyFlat",      "animation.vert",          "minion-destroy-flat.frag"),
+			loadAnimationShader(headless, "minionDestroyBillboard", "textured-animation.vert", "minion-destroy-billboard.frag"),
+			loadAnimationShader(headless, "playerDamage",           "animation.vert",          "player-damage.frag"),
+			loadAnimationShader(headless, "playerDestroyFlat",      "animation.vert",          "player-destroy-flat.frag"),
+			loadAnimationShader(headless, "playerDestroyBillboard", "animation.vert",          "player-destroy-billboard.frag"),
+			loadAnimationShader(headless, "particleCube",           "particle-cube.vert",      "particle-cube.frag"),
+		};
+	}
+}
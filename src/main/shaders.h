@@ -0,0 +1,16 @@
+#ifndef HACK_GAME__MAIN__SHADERS_H
+#define HACK_GAME__MAIN__SHADERS_H
+
+#include "shader/shader_manager.h"
+
+namespace hack_game {
+
+	/**
+	 * @brief Компилирует все шейдеры игры
+	 * @param headless если true, то все шейдеры пустые (id = 0) и OpenGL не используется.
+	 * Такой менеджер нужен для симуляции без окна (--headless) и для бенчмарков
+	 */
+	ShaderManager createShaderManager(GLint windowWidth, GLint windowHeight, bool headless);
+}
+
+#endif
@@ -0,0 +1,211 @@
+#include "simulation.h"
+#include "level/level.h"
+#include "entity/entity.h"
+#include "entity/player.h"
+#include "input_recording.h"
+#include "memory/alloc_counter.h"
+#include "trace.h"
+
+#include <algorithm>
+
+namespace hack_game {
+
+	using std::shared_ptr;
+	using std::lock_guard;
+	using std::mutex;
+
+	using clock = std::chrono::steady_clock;
+	using std::chrono::duration;
+	using std::chrono::duration_cast;
+
+
+	Simulation::Simulation(const TickSettings& tickSettings, InputRecording* recording):
+			tickSettings(tickSettings),
+			recording(recording),
+			thread(&Simulation::run, this) {}
+
+	Simulation::~Simulation() {
+		stopped = true;
+		thread.join();
+	}
+
+
+	void Simulation::setLevel(const shared_ptr<Level>& newLevel) {
+		lock_guard lock(mutex);
+
+		if (level != newLevel) {
+			level = newLevel;
+			levelId = newLevel != nullptr ? ++lastLevelId : 0;
+		}
+	}
+
+	void Simulation::setInput(const PlayerInput& newInput) {
+		lock_guard lock(mutex);
+
+		const PlayerInput::Turn turn = input.turn;
+		input = newInput;
+
+		if (input.turn == PlayerInput::Turn::NONE) {
+			input.turn = turn;
+		}
+	}
+
+	void Simulation::setPaused(bool value) noexcept {
+		paused = value;
+	}
+
+	void Simulation::step() noexcept {
+		pendingSteps += 1;
+
+		while (pendingSteps > 0 && !stopped) {
+			std::this_thread::yield();
+		}
+	}
+
+
+	const RenderSnapshot* Simulation::getSnapshot() noexcept {
+		snapshots.update();
+		const RenderSnapshot& snapshot = snapshots.getReadBuffer();
+
+		// levelId изменяется только в этом же потоке (setLevel), поэтому читать его можно без блокировки
+		return snapshot.levelId != 0 && snapshot.levelId == levelId ? &snapshot : nullptr;
+	}
+
+	float Simulation::getTickProgress(const RenderSnapshot& snapshot) const noexcept {
+		const float time = duration<float>(clock::now() - snapshot.tickTime).count();
+		return std::clamp(time / tickSettings.getTickTime(), 0.0f, 1.0f);
+	}
+
+
+	void Simulation::run() {
+		trace::setThreadName("simulation");
+
+		const float tickTime = tickSettings.getTickTime();
+		const clock::duration tickDuration = duration_cast<clock::duration>(duration<float>(tickTime));
+		const clock::duration maxLag = tickDuration * tickSettings.maxCatchUpTicks;
+
+		clock::time_point nextTick = clock::now();
+		uint64_t recordedLevelId = 0;
+
+		while (!stopped) {
+			const bool step = pendingSteps > 0;
+
+			if (paused && !step) {
+				std::this_thread::sleep_for(tickDuration);
+				nextTick = clock::now();
+				continue;
+			}
+
+			shared_ptr<Level> currentLevel;
+			uint64_t currentLevelId;
+			PlayerInput currentInput;
+
+			{
+				lock_guard lock(mutex);
+				currentLevel = level;
+				currentLevelId = levelId;
+				currentInput = input;
+				input.turn = PlayerInput::Turn::NONE;
+			}
+
+			const size_t allocationsBefore = getThreadHeapAllocationCount();
+
+			if (currentLevel != nullptr && recording != nullptr) {
+				if (currentLevelId != recordedLevelId) {
+					recording->beginLevel(*currentLevel);
+					recordedLevelId = currentLevelId;
+				}
+
+				if (!recording->nextTick(currentInput)) {
+					replayFinished = true;
+				}
+			}
+
+			if (currentLevel != nullptr) {
+				currentLevel->setDeltaTime(tickTime);
+				currentLevel->getPlayer()->setInput(currentInput);
+				tick(*currentLevel);
+			}
+
+			publishSnapshot(currentLevel.get(), currentLevelId, nextTick, allocationsBefore);
+
+			if (step) {
+				pendingSteps -= 1;
+				nextTick = clock::now();
+			}
+
+			nextTick += tickDuration;
+
+			// Если симуляция отстала слишком сильно, лишнее время отбрасывается
+			const clock::time_point now = clock::now();
+			if (now - nextTick > maxLag) {
+				nextTick = now;
+			}
+
+			std::this_thread::sleep_until(nextTick);
+		}
+	}
+
+
+	void Simulation::publishSnapshot(const Level* currentLevel, uint64_t currentLevelId, clock::time_point tickTime, size_t allocationsBefore) {
+		TRACE_ZONE("publishSnapshot");
+
+		RenderSnapshot& snapshot = snapshots.getWriteBuffer();
+		snapshot.clear();
+
+		if (currentLevel != nullptr) {
+			snapshot.levelId = currentLevelId;
+			snapshot.tickTime = tickTime;
+			draw(*currentLevel, snapshot);
+			snapshot.tickAllocations = getThreadHeapAllocationCount() - allocationsBefore;
+		}
+
+		snapshots.publish();
+	}
+
+
+	static void draw(RenderPass pass, const Level::EntityMap& entityMap, RenderSnapshot& snapshot) {
+		snapshot.drawList.setPass(pass);
+
+		for (const auto& entry : entityMap) {
+			// Уровень заранее создаёт контейнеры для всех шейдеров, большинство из них пустые
+			if (entry.second.empty()) continue;
+
+			snapshot.entityBuckets.push_back(EntityBucket { pass, entry.first, entry.second.size() });
+
+			for (const auto& entity : entry.second) {
+				entity->draw(snapshot.drawList);
+			}
+		}
+	}
+
+
+	void draw(const Level& level, RenderSnapshot& snapshot) {
+		const Player& player = *level.getPlayer();
+		snapshot.view = player.getCamera().getView();
+		snapshot.viewTickOffset = player.getTickOffset();
+
+		draw(RenderPass::OPAQUE, level.getOpaqueEntityMap(), snapshot);
+		draw(RenderPass::TRANSPARENT, level.getTransparentEntityMap(), snapshot);
+
+		snapshot.drawList.sort(snapshot.view);
+	}
+
+
+	static void tick(Level& level, const Level::EntityMap& entityMap) {
+		for (auto& entry : entityMap) {
+			for (const auto& entity : entry.second) {
+				entity->tick(level);
+			}
+		}
+	}
+
+
+	void tick(Level& level) {
+		TRACE_ZONE("tick");
+
+		tick(level, level.getOpaqueEntityMap());
+		tick(level, level.getTransparentEntityMap());
+		level.updateEntities();
+	}
+}
@@ -0,0 +1,96 @@
+#ifndef HACK_GAME__MAIN__SIMULATION_H
+#define HACK_GAME__MAIN__SIMULATION_H
+
+#include "main.h"
+#include "entity/player.h"
+#include "render/render_snapshot.h"
+#include "render/triple_buffer.h"
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+
+namespace hack_game {
+
+	class Level;
+	class InputRecording;
+
+	/**
+	 * @brief Поток симуляции. Выполняет тики уровня с фиксированным шагом и после каждого тика
+	 * публикует снимок сцены (RenderSnapshot) через lock-free тройной буфер.
+	 * Поток OpenGL не обращается к сущностям уровня, а только читает снимки.
+	 */
+	class Simulation {
+		const TickSettings& tickSettings;
+		InputRecording* const recording; // Используется только потоком симуляции, пока он работает
+		TripleBuffer<RenderSnapshot> snapshots;
+
+		std::mutex mutex; // Защищает level, levelId и input
+		std::shared_ptr<Level> level = nullptr;
+		uint64_t levelId = 0;
+		PlayerInput input;
+
+		uint64_t lastLevelId = 0; // Номер последнего уровня, переданного через setLevel. Используется только потоком OpenGL
+
+		std::atomic<bool> paused = false;
+		std::atomic<int> pendingSteps = 0;
+		std::atomic<bool> stopped = false;
+		std::atomic<bool> replayFinished = false;
+
+		std::thread thread;
+
+	public:
+		/**
+		 * @brief Запускает поток симуляции
+		 * @param recording запись, в которую попадает управление каждого тика уровня, или из которой оно берётся
+		 * вместо setInput. nullptr, если запись не нужна
+		 */
+		Simulation(const TickSettings&, InputRecording* recording);
+
+		/// @brief Останавливает поток симуляции и ждёт его завершения
+		~Simulation();
+
+		Simulation(const Simulation&) = delete;
+		Simulation& operator=(const Simulation&) = delete;
+
+		/// @brief Передаёт уровень потоку симуляции. Ничего не делает, если уровень не изменился
+		void setLevel(const std::shared_ptr<Level>&);
+
+		/// @brief Передаёт состояние управления игроком. Повороты игрока сохраняются до следующего тика
+		void setInput(const PlayerInput&);
+
+		void setPaused(bool) noexcept;
+
+		/// @return true, если воспроизводимая запись закончилась
+		bool isReplayFinished() const noexcept {
+			return replayFinished;
+		}
+
+		/// @brief Выполняет ровно один тик на паузе и ждёт, пока его снимок будет опубликован
+		void step() noexcept;
+
+		/// @brief Забирает последний опубликованный снимок
+		/// @return Снимок текущего уровня или nullptr, если уровня нет или снимок ещё не готов.
+		/// Снимок не изменяется до следующего вызова этого метода
+		const RenderSnapshot* getSnapshot() noexcept;
+
+		/**
+		 * @return Время, прошедшее с тика снимка, в долях от длины тика (от 0 до 1).
+		 * Используется для интерполяции позиций между двумя последними тиками
+		 */
+		float getTickProgress(const RenderSnapshot&) const noexcept;
+
+	private:
+		void run();
+		void publishSnapshot(const Level*, uint64_t levelId, std::chrono::steady_clock::time_point tickTime, size_t allocationsBefore);
+	};
+
+	/// @brief Обновляет состояние всех сущностей уровня, затем добавляет и удаляет отложенные сущности
+	void tick(Level&);
+
+	/// @brief Записывает команды отрисовки всех сущностей уровня в снимок и сортирует их
+	void draw(const Level&, RenderSnapshot&);
+}
+
+#endif
@@ -1,7 +1,16 @@
 #include "main.h"
+#include "headless.h"
+#include "input_recording.h"
+#include "shaders.h"
 #include "shader/shader_loader.h"
-#include "shader/shader_manager.h"
-
+#include "dir_paths.h"
+#include "asset/asset_loader.h"
+#include "model/model.h"
+#include "trace.h"
+
+#include <fstream>
+#include <optional>
+#include <algorithm>
 #include <GLFW/glfw3.h>
 
 namespace hack_game {
@@ -13,60 +22,137 @@ namespace hack_game {
 
 
 	static bool profile = false;
+	static bool traceEnabled = false;
+	static bool lines = false;
+	static TickSettings tickSettings;
+
+	static bool headless = false;
+	static std::string headlessLevel = LEVELS_DIR "level1.json";
+	static int headlessTicks = 10000;
+	static bool headlessTicksSet = false;
+
+	static std::string recordingPath; // Пустой, если нет ни --record, ни --replay
+	static bool replay = false;
+	static std::optional<uint64_t> seed;
 
 	static void parse_args(int argc, const char* argv[]) {
 		for (int i = 1; i < argc; i++) {
 			std::string arg = argv[i];
 
 			if (arg == "--lines") {
-				glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+				lines = true;
 			} else if (arg == "--profile") {
 				profile = true;
+			} else if (arg == "--trace") {
+				traceEnabled = true;
+			} else if (arg == "--headless") {
+				headless = true;
+
+				if (i + 1 < argc && argv[i + 1][0] != '-') {
+					headlessLevel = argv[++i];
+				}
+			} else if (arg == "--ticks" && i + 1 < argc) {
+				headlessTicks = std::stoi(argv[++i]);
+				headlessTicksSet = true;
+			} else if ((arg == "--record" || arg == "--replay") && i + 1 < argc) {
+				recordingPath = argv[++i];
+				replay = arg == "--replay";
+			} else if (arg == "--seed" && i + 1 < argc) {
+				seed = std::stoull(argv[++i]);
+			} else if (arg == "--tick-rate" && i + 1 < argc) {
+				tickSettings.tickRate = std::stof(argv[++i]);
+			} else if (arg == "--max-catch-up" && i + 1 < argc) {
+				tickSettings.maxCatchUpTicks = std::max(1, std::stoi(argv[++i]));
 			}
 		}
 	}
 }
 
 
-#define ANIMATION_SHADER(name, vertexShader, fragmentShader) Shader(name, createAnimationShaderProgram(vertexShader, fragmentShader))
-
 int main(int argc, const char* argv[]) {
 	using namespace hack_game;
 
 	try {
-		srand(time(nullptr));
+		parse_args(argc, argv);
+
+		// При воспроизведении зерно, частота тиков и уровень берутся из записи. Зерно задаётся в InputRecording::beginLevel
+		std::optional<InputRecording> recording;
+
+		if (replay) {
+			recording.emplace(recordingPath);
+			tickSettings.tickRate = recording->getTickRate();
+			headlessLevel = recording->getLevelPath();
+
+			if (!headlessTicksSet) {
+				headlessTicks = static_cast<int>(recording->getTickCount());
+			}
 
+		} else if (!recordingPath.empty()) {
+			recording.emplace(tickSettings.tickRate);
+		}
+
+		InputRecording* const recordingPtr = recording.has_value() ? &*recording : nullptr;
+
+		if (traceEnabled) {
+			trace::enable();
+			trace::setThreadName("main");
+		}
+
+		if (headless) {
+			ShaderManager shaderManager = createShaderManager(0, 0, true);
+			headlessLoop(shaderManager, headlessLevel, headlessTicks, tickSettings.getTickTime(), recordingPtr, seed, profile);
+
+			if (recording.has_value() && !replay) {
+				recording->save(recordingPath);
+			}
+
+			if (traceEnabled) {
+				trace::dump();
+			}
+
+			return 0;
+		}
+
+		// Ресурсы загружаются в рабочих потоках, пока главный поток создаёт окно и контекст OpenGL
+		AssetLoader assetLoader;
 		const RenderContext& renderContext = RenderContext::getInstance();
 
-		parse_args(argc, argv);
-		
-
-		ShaderManager shaderManager {
-			renderContext.getWindowWidth(),
-			renderContext.getWindowHeight(),
-			Shader("null"),
-			Shader("main",           createShaderProgram("main.vert",           "main.frag")),
-			Shader("light",          createShaderProgram("light.vert",          "light.frag")),
-			Shader("postprocessing", createShaderProgram("postprocessing.vert", "postprocessing.frag")),
-			ANIMATION_SHADER("enemyDamage",            "animation.vert",          "enemy-damage.frag"),
-			ANIMATION_SHADER("enemyDestroyFlat",       "animation.vert",          "enemy-destroy-flat.frag"),
-			ANIMATION_SHADER("enemyDestroyBillboard",  "textured-animation.vert", "enemy-destroy-billboard.frag"),
-			ANIMATION_SHADER("minionDestroyFlat",      "animation.vert",          "minion-destroy-flat.frag"),
-			ANIMATION_SHADER("minionDestroyBillboard", "textured-animation.vert", "minion-destroy-billboard.frag"),
-			ANIMATION_SHADER("playerDamage",           "animation.vert",          "player-damage.frag"),
-			ANIMATION_SHADER("playerDestroyFlat",      "animation.vert",          "player-destroy-flat.frag"),
-			ANIMATION_SHADER("playerDestroyBillboard", "animation.vert",          "player-destroy-billboard.frag"),
-			ANIMATION_SHADER("particleCube",           "animation.vert",          "particle-cube.frag"),
-		};
+		if (profile) {
+			std::ofstream assetsLog("/tmp/assets.log");
+			assetLoader.wait(&assetsLog);
+		} else {
+			assetLoader.wait(nullptr);
+		}
+
+		{
+			TRACE_ZONE("generateVertexArrays");
+
+			for (Model* model : Model::getModels()) {
+				model->generateVertexArray();
+			}
+		}
 
+		if (lines) {
+			glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+		}
+
+		ShaderManager shaderManager = createShaderManager(renderContext.getWindowWidth(), renderContext.getWindowHeight(), false);
 		staticShaderManager = &shaderManager;
 
 		onShadersLoaded();
-		mainLoop(renderContext, shaderManager, profile);
+		mainLoop(renderContext, shaderManager, tickSettings, recordingPtr, seed, profile);
+
+		if (recording.has_value() && !replay) {
+			recording->save(recordingPath);
+		}
+
+		if (traceEnabled) {
+			trace::dump();
+		}
 
 		return 0;
-		
+
 	} catch (...) {
 		throw;
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,65 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace hack_game {
+	using std::string;
+
+#ifdef _WIN32
+	MappedFile::MappedFile(const string& path) {
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+		if (!file.is_open()) {
+			return;
+		}
+
+		buffer.resize(static_cast<size_t>(file.tellg()));
+		file.seekg(0);
+
+		if (buffer.empty() || !file.read(reinterpret_cast<char*>(buffer.data()), std::streamsize(buffer.size()))) {
+			return;
+		}
+
+		data = buffer.data();
+		size = buffer.size();
+	}
+
+	MappedFile::~MappedFile() {}
+
+#else
+	MappedFile::MappedFile(const string& path) {
+		const int fd = open(path.c_str(), O_RDONLY);
+
+		if (fd < 0) {
+			return;
+		}
+
+		struct stat info;
+
+		if (fstat(fd, &info) == 0 && info.st_size > 0) {
+			void* mapped = mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+			if (mapped != MAP_FAILED) {
+				data = static_cast<const uint8_t*>(mapped);
+				size = size_t(info.st_size);
+			}
+		}
+
+		// Отображение остаётся действительным и после закрытия файла
+		close(fd);
+	}
+
+	MappedFile::~MappedFile() {
+		if (data != nullptr) {
+			munmap(const_cast<uint8_t*>(data), size);
+		}
+	}
+#endif
+}
@@ -0,0 +1,44 @@
+#ifndef HACK_GAME__MAPPED_FILE_H
+#define HACK_GAME__MAPPED_FILE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace hack_game {
+
+	/**
+	 * @brief Файл, отображённый в память только для чтения. Данные доступны, пока объект жив.
+	 * На платформах без mmap файл читается в память целиком
+	 */
+	class MappedFile {
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+
+	#ifdef _WIN32
+		std::vector<uint8_t> buffer;
+	#endif
+
+	public:
+		/// @brief Отображает файл в память. Если файл не удалось открыть или он пустой, то isOpen() вернёт false
+		explicit MappedFile(const std::string& path);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool isOpen() const noexcept {
+			return data != nullptr;
+		}
+
+		const uint8_t* getData() const noexcept {
+			return data;
+		}
+
+		size_t getSize() const noexcept {
+			return size;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,38 @@
+#include "alloc_counter.h"
+#include <atomic>
+
+namespace hack_game {
+	static std::atomic<bool> heapAllocationCountEnabled = false;
+	static std::atomic<size_t> heapAllocationCount = 0;
+	static std::atomic<size_t> poolOverflowCount = 0;
+	static thread_local size_t threadHeapAllocationCount = 0;
+
+	bool isHeapAllocationCountEnabled() noexcept {
+		return heapAllocationCountEnabled.load(std::memory_order_relaxed);
+	}
+
+	size_t getHeapAllocationCount() noexcept {
+		return heapAllocationCount.load(std::memory_order_relaxed);
+	}
+
+	size_t getThreadHeapAllocationCount() noexcept {
+		return threadHeapAllocationCount;
+	}
+
+	size_t getPoolOverflowCount() noexcept {
+		return poolOverflowCount.load(std::memory_order_relaxed);
+	}
+
+	void onPoolOverflow() noexcept {
+		poolOverflowCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void onHeapAllocation() noexcept {
+		heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+		threadHeapAllocationCount += 1;
+	}
+
+	void enableHeapAllocationCount() noexcept {
+		heapAllocationCountEnabled.store(true, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,32 @@
+#ifndef HACK_GAME__MEMORY__ALLOC_COUNTER_H
+#define HACK_GAME__MEMORY__ALLOC_COUNTER_H
+
+#include <cstddef>
+
+namespace hack_game {
+
+	/// @return true, если в программу собраны замены operator new из alloc_hooks.cpp (опция COUNT_ALLOCATIONS).
+	/// Иначе счётчики выделений памяти всегда равны нулю
+	bool isHeapAllocationCountEnabled() noexcept;
+
+	/// @return Количество вызовов operator new во всех потоках с начала работы программы
+	size_t getHeapAllocationCount() noexcept;
+
+	/// @return Количество вызовов operator new в текущем потоке с начала его работы.
+	/// Чтобы посчитать выделения памяти в участке кода, нужно взять разность значений до и после него
+	size_t getThreadHeapAllocationCount() noexcept;
+
+	/// @return Количество выделений, которые не поместились в пулы объектов (ObjectPool) и были переданы в operator new
+	size_t getPoolOverflowCount() noexcept;
+
+	/// @brief Увеличивает счётчик getPoolOverflowCount
+	void onPoolOverflow() noexcept;
+
+	/// @brief Вызывается из operator new в alloc_hooks.cpp
+	void onHeapAllocation() noexcept;
+
+	/// @brief Вызывается один раз при запуске из alloc_hooks.cpp
+	void enableHeapAllocationCount() noexcept;
+}
+
+#endif
@@ -0,0 +1,54 @@
+#include "alloc_counter.h"
+#include <new>
+#include <cstdlib>
+
+// Замена глобальных operator new и operator delete для подсчёта выделений памяти.
+// Собирается только в бенчмарки и, с опцией COUNT_ALLOCATIONS, в игру, поэтому не входит в библиотеку core.
+// Формы new[] и nothrow по умолчанию вызывают operator new(size_t) или operator new(size_t, align_val_t),
+// а delete[] - соответствующий operator delete, поэтому заменяются только эти функции
+
+namespace hack_game {
+	static const bool heapAllocationCountEnabled = (enableHeapAllocationCount(), true);
+}
+
+void* operator new(size_t size) {
+	hack_game::onHeapAllocation();
+
+	void* ptr = std::malloc(size == 0 ? 1 : size);
+
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+
+	return ptr;
+}
+
+// std::aligned_alloc требует размер, кратный выравниванию
+void* operator new(size_t size, std::align_val_t alignment) {
+	hack_game::onHeapAllocation();
+
+	const size_t align = static_cast<size_t>(alignment);
+	void* ptr = std::aligned_alloc(align, size == 0 ? align : (size + align - 1) / align * align);
+
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+
+	return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+	std::free(ptr);
+}
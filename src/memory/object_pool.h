@@ -0,0 +1,141 @@
+#ifndef HACK_GAME__MEMORY__OBJECT_POOL_H
+#define HACK_GAME__MEMORY__OBJECT_POOL_H
+
+#include "alloc_counter.h"
+#include <new>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+
+namespace hack_game {
+
+	/**
+	 * @brief Пул фиксированной ёмкости для объектов одного типа. Память выделяется один раз при первом обращении
+	 * к пулу и не освобождается до завершения программы. Свободные ячейки хранятся в односвязном списке.
+	 * Объекты могут освобождаться из любого потока (например, при удалении уровня в потоке OpenGL),
+	 * поэтому доступ к списку защищён мьютексом.
+	 */
+	template<typename T, size_t Capacity>
+	class ObjectPool {
+		union Slot {
+			Slot* next;
+			alignas(T) std::byte storage[sizeof(T)];
+		};
+
+		Slot slots[Capacity];
+		Slot* freeList = nullptr;
+		std::mutex mutex;
+
+		ObjectPool() noexcept {
+			for (size_t i = Capacity; i > 0; i--) {
+				slots[i - 1].next = freeList;
+				freeList = &slots[i - 1];
+			}
+		}
+
+	public:
+		ObjectPool(const ObjectPool&) = delete;
+		ObjectPool& operator=(const ObjectPool&) = delete;
+
+		/// Пул создаётся в статической памяти и никогда не разрушается: объекты из статических переменных
+		/// (например, уровень статического меню в mainLoop) возвращаются в пул уже после разрушения остальной статики
+		static ObjectPool& getInstance() noexcept {
+			alignas(ObjectPool) static std::byte storage[sizeof(ObjectPool)];
+			static ObjectPool* const instance = new (storage) ObjectPool();
+			return *instance;
+		}
+
+		/// @return Указатель на неинициализированную память для одного объекта или nullptr, если пул заполнен
+		T* allocate() noexcept {
+			std::lock_guard lock(mutex);
+
+			if (freeList == nullptr) {
+				return nullptr;
+			}
+
+			Slot* slot = freeList;
+			freeList = slot->next;
+			return reinterpret_cast<T*>(slot->storage);
+		}
+
+		/// @return true, если память принадлежит этому пулу
+		bool owns(const T* ptr) const noexcept {
+			const std::byte* bytes = reinterpret_cast<const std::byte*>(ptr);
+			return bytes >= slots[0].storage && bytes <= slots[Capacity - 1].storage;
+		}
+
+		/// @brief Возвращает память в пул. Память должна принадлежать этому пулу (owns)
+		void deallocate(T* ptr) noexcept {
+			Slot* slot = reinterpret_cast<Slot*>(ptr);
+
+			std::lock_guard lock(mutex);
+			slot->next = freeList;
+			freeList = slot;
+		}
+	};
+
+
+	/**
+	 * @brief Аллокатор для std::allocate_shared, который берёт память из ObjectPool.
+	 * std::allocate_shared размещает объект вместе с блоком управления, поэтому пул создаётся
+	 * для типа блока управления, а не для самого объекта. Если пул заполнен, память выделяется обычным образом.
+	 */
+	template<typename T, size_t Capacity>
+	class PoolAllocator {
+		using Pool = ObjectPool<T, Capacity>;
+
+	public:
+		using value_type = T;
+
+		template<typename U>
+		struct rebind {
+			using other = PoolAllocator<U, Capacity>;
+		};
+
+		PoolAllocator() noexcept = default;
+
+		template<typename U>
+		PoolAllocator(const PoolAllocator<U, Capacity>&) noexcept {}
+
+		T* allocate(size_t n) {
+			if (n == 1) {
+				T* ptr = Pool::getInstance().allocate();
+
+				if (ptr != nullptr) {
+					return ptr;
+				}
+			}
+
+			onPoolOverflow();
+			return std::allocator<T>().allocate(n);
+		}
+
+		void deallocate(T* ptr, size_t n) noexcept {
+			Pool& pool = Pool::getInstance();
+
+			if (n == 1 && pool.owns(ptr)) {
+				pool.deallocate(ptr);
+			} else {
+				std::allocator<T>().deallocate(ptr, n);
+			}
+		}
+
+		template<typename U>
+		bool operator==(const PoolAllocator<U, Capacity>&) const noexcept {
+			return true;
+		}
+	};
+
+
+	/**
+	 * @brief Создаёт объект в пуле. Ёмкость пула задаётся константой T::POOL_CAPACITY
+	 * @return Указатель на объект. Объект и его блок управления возвращаются в пул,
+	 * когда удаляется последний shared_ptr и последний weak_ptr на объект
+	 */
+	template<typename T, typename... Args>
+	std::shared_ptr<T> makePooled(Args&&... args) {
+		return std::allocate_shared<T>(PoolAllocator<T, T::POOL_CAPACITY>(), std::forward<Args>(args)...);
+	}
+}
+
+#endif
@@ -1,25 +1,19 @@
 #include "colored_model.h"
 #include "shader/shader.h"
 #include "dir_paths.h"
+#include "obj_loader.h"
 #include "util.h"
 
-#include <fstream>
-#include <map>
-
 #define GLEW_STATIC
 #include <GL/glew.h>
 
 namespace hack_game {
 	using std::string;
 	using std::vector;
-	using std::map;
-	using std::pair;
-	using std::ifstream;
-	using std::streamsize;
-	using std::numeric_limits;
 
 	using glm::vec3;
 
+	using Vertex = ColoredModel::Vertex;
 
 	struct ColoredModel::Vertex {
 		const glm::vec3 pos;
@@ -30,98 +24,46 @@ namespace hack_game {
 	};
 
 
-	ColoredModel::ColoredModel(uint32_t color, const char* relativePath): color(colorAsVec3(color)) {
-		const string path = string(MODELS_DIR) + relativePath;
-		ifstream file(path);
-
-		if (!file.is_open()) {
-			throw std::ios_base::failure("Cannot open file '" + path + "'");
-		}
-
-		vector<vec3> positions;
-		vector<vec3> normals;
-		map<pair<uint32_t, uint32_t>, uint32_t> verticesMap; // Ключ: {позиция, нормаль}, значение: индекс вершины
-
-		for (string tag; file >> tag;) {
-
-			if (tag == "v") {
-				vec3& vec = positions.emplace_back();
-				file >> vec.x >> vec.y >> vec.z;
-				continue;
-			}
+	static void loadVertices(const string& path, vector<Vertex>& vertices, vector<GLuint>& indices) {
+		obj_loader::ObjMesh obj = obj_loader::load(path, obj_loader::NORMALS | obj_loader::TRIANGULATE);
 
-			if (tag == "vn") {
-				vec3& vec = normals.emplace_back();
-				file >> vec.x >> vec.y >> vec.z;
-				continue;
-			}
+		vertices.reserve(obj.vertices.size());
 
-			if (tag == "f") {
-				for (int i = 0; i < 3; i++) {
-					uint32_t posIndex; file >> posIndex;
-
-					file.ignore(numeric_limits<streamsize>::max(), '/');
-					file.ignore(numeric_limits<streamsize>::max(), '/');
+		for (const obj_loader::ObjVertex& vertex : obj.vertices) {
+			vertices.emplace_back(obj.positions[vertex.position], obj.normals[vertex.normal]);
+		}
 
-					uint32_t normalIndex; file >> normalIndex;
-					posIndex--, normalIndex--;
+		indices = std::move(obj.triangles);
+	}
 
-					auto it = verticesMap.find({posIndex, normalIndex});
 
-					if (it != verticesMap.end()) {
-						indices.push_back(it->second);
+	MeshArena& ColoredModel::getArena() {
+		static MeshArena arena("colored", [] () {
+			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<GLvoid*>(offsetof(Vertex, pos)));
+			glEnableVertexAttribArray(0);
 
-					} else {
-						vertices.emplace_back(positions[posIndex], normals[normalIndex]);
-						
-						const uint32_t index = vertices.size() - 1;
-						verticesMap[{posIndex, normalIndex}] = index;
-						indices.push_back(index);
-					}
-				}
+			glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<GLvoid*>(offsetof(Vertex, normal)));
+			glEnableVertexAttribArray(1);
+		}, loadVertices);
 
-				if (file.get() != '\n') {
-					throw std::invalid_argument("File '" + path + "' contains more, than 3 vertices for one face");
-				}
+		return arena;
+	}
 
-				continue;
-			}
 
-			file.ignore(numeric_limits<streamsize>::max(), '\n');
-		}
+	ColoredModel::ColoredModel(uint32_t color, const char* relativePath): color(colorAsVec3(color)) {
+		mesh = &getArena().request(string(MODELS_DIR) + relativePath);
 	}
 
 
 	ColoredModel::ColoredModel(uint32_t color, const ColoredModel& model):
 		VAOModel(model),
-		vertices(model.vertices),
 		color(colorAsVec3(color)) {}
 	
 	ColoredModel::~ColoredModel() {}
 
 
 	GLuint ColoredModel::createVertexArray() {
-		GLuint buffers[2], VAO;
-		glGenBuffers(2, buffers);
-		glGenVertexArrays(1, &VAO);
-		
-		
-		glBindVertexArray(VAO);
-
-		glBindBuffer(GL_ARRAY_BUFFER, buffers[0]);	
-		glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(vertices.size() * sizeof(vertices[0])), &vertices[0], GL_STATIC_DRAW);
-
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers[1]);	
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, GLsizeiptr(indices.size() * sizeof(indices[0])), &indices[0], GL_STATIC_DRAW);
-
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<GLvoid*>(offsetof(Vertex, pos)));
-		glEnableVertexAttribArray(0);
-
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<GLvoid*>(offsetof(Vertex, normal)));
-		glEnableVertexAttribArray(1);
-		
-		glBindVertexArray(0);
-		return VAO;
+		return getArena().upload();
 	}
 
 
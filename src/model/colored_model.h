@@ -7,9 +7,10 @@
 namespace hack_game {
 
 	class ColoredModel: public VAOModel {
+	public:
 		struct Vertex;
 
-		std::vector<Vertex> vertices;
+	private:
 		const glm::vec3 color;
 	
 	public:
@@ -25,6 +26,10 @@ namespace hack_game {
 
 		void draw(Shader&) const override;
 		void draw(Shader&, const glm::vec3& color) const;
+	
+	private:
+		/// @return Общую арену мешей всех цветных моделей
+		static MeshArena& getArena();
 	};
 }
 
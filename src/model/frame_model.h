@@ -8,7 +8,6 @@ namespace hack_game {
 
 	class FrameModel: public VAOModel {
 		const glm::vec3 color;
-		std::vector<glm::vec3> vertices;
 
 	public:
 		FrameModel(uint32_t color, const char* relativePath);
@@ -17,6 +16,11 @@ namespace hack_game {
 	
 	protected:
 		GLuint createVertexArray() override;
+		GLenum getPrimitiveType() const noexcept override;
+	
+	private:
+		/// @return Общую арену мешей всех каркасных моделей
+		static MeshArena& getArena();
 	};
 }
 
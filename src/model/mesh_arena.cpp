@@ -0,0 +1,134 @@
+#include "mesh_arena.h"
+#include "mesh_cache.h"
+#include "mapped_file.h"
+#include "render/gl_state.h"
+
+#include <cassert>
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+namespace hack_game {
+	using std::string;
+	using std::vector;
+	using std::optional;
+
+	/// Меш из одного файла. Загружается с диска в рабочем потоке и хранится здесь до загрузки арены в видеопамять
+	class MeshArena::Entry: public Asset {
+		const MeshArena& arena;
+		const string path;
+
+	public:
+		Mesh mesh;
+		vector<uint8_t> vertexData;
+		vector<GLuint> indices;
+		bool loaded = false;
+
+		Entry(const MeshArena& arena, const string& path, uint32_t id):
+				arena(arena), path(path), mesh { .id = id } {}
+
+		const string& getPath() const noexcept override {
+			return path;
+		}
+
+		void load() override {
+			const optional<uint64_t> sourceHash = mesh_cache::hashSource(path);
+			const string cachePath = mesh_cache::getCachePath(path, arena.format);
+
+			if (sourceHash.has_value()) {
+				// Данные копируются прямо из отображённого в память файла
+				const MappedFile cacheFile(cachePath);
+				const optional<mesh_cache::MeshData> data = mesh_cache::load(cacheFile, *sourceHash, arena.vertexSize);
+
+				if (data.has_value()) {
+					const uint8_t* vertices = static_cast<const uint8_t*>(data->vertices);
+					vertexData.assign(vertices, vertices + data->verticesSize);
+					indices.assign(data->indices, data->indices + data->indexCount);
+					loaded = true;
+					return;
+				}
+			}
+
+			arena.parser(path, vertexData, indices);
+			assert(vertexData.size() % arena.vertexSize == 0);
+
+			if (sourceHash.has_value()) {
+				mesh_cache::save(cachePath, *sourceHash, arena.vertexSize,
+						mesh_cache::MeshData { vertexData.data(), vertexData.size(), indices.data(), indices.size() });
+			}
+
+			loaded = true;
+		}
+	};
+
+
+	MeshArena::MeshArena(const char* format, size_t vertexSize, void (*setupAttributes)(), Parser parser):
+			format(format), vertexSize(vertexSize), setupAttributes(setupAttributes), parser(std::move(parser)) {}
+
+	MeshArena::~MeshArena() {}
+
+
+	const Mesh& MeshArena::request(const string& path) {
+		assert(vertexArray == 0 && "Mesh requested after the arena was uploaded");
+
+		Entry*& entry = entriesByPath[path];
+
+		if (entry == nullptr) {
+			entry = entries.emplace_back(std::make_unique<Entry>(*this, path, entries.size())).get();
+		}
+
+		return entry->mesh;
+	}
+
+
+	GLuint MeshArena::upload() {
+		if (vertexArray != 0) {
+			return vertexArray;
+		}
+
+		size_t verticesSize = 0, indexCount = 0;
+
+		for (const std::unique_ptr<Entry>& entry : entries) {
+			assert(entry->loaded && "Mesh arena uploaded before its meshes were loaded");
+
+			entry->mesh.baseVertex = GLint(verticesSize / vertexSize);
+			entry->mesh.firstIndex = GLuint(indexCount);
+			entry->mesh.indexCount = GLsizei(entry->indices.size());
+
+			verticesSize += entry->vertexData.size();
+			indexCount += entry->indices.size();
+		}
+
+		GLuint buffers[2];
+		glGenBuffers(2, buffers);
+		glGenVertexArrays(1, &vertexArray);
+
+
+		gl_state::bindVertexArray(vertexArray);
+
+		// Меши копируются из своих буферов прямо в видеопамять, без склейки в оперативной памяти
+		glBindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+		glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(verticesSize), nullptr, GL_STATIC_DRAW);
+
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers[1]);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, GLsizeiptr(indexCount * sizeof(GLuint)), nullptr, GL_STATIC_DRAW);
+
+		for (const std::unique_ptr<Entry>& entry : entries) {
+			const Mesh& mesh = entry->mesh;
+
+			glBufferSubData(GL_ARRAY_BUFFER, GLintptr(mesh.baseVertex * vertexSize),
+					GLsizeiptr(entry->vertexData.size()), entry->vertexData.data());
+
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, GLintptr(mesh.firstIndex * sizeof(GLuint)),
+					GLsizeiptr(entry->indices.size() * sizeof(GLuint)), entry->indices.data());
+
+			vector<uint8_t>().swap(entry->vertexData);
+			vector<GLuint>().swap(entry->indices);
+		}
+
+		setupAttributes();
+
+		gl_state::bindVertexArray(0);
+		return vertexArray;
+	}
+}
@@ -0,0 +1,96 @@
+#ifndef HACK_GAME__MODEL__MESH_ARENA_H
+#define HACK_GAME__MODEL__MESH_ARENA_H
+
+#include "asset/asset.h"
+#include "gl_fwd.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+namespace hack_game {
+
+	/// Участок общего буфера арены, занятый одним мешем. Заполняется при загрузке арены в видеопамять
+	struct Mesh {
+		GLint baseVertex = 0;   // Индекс первой вершины меша в буфере вершин
+		GLuint firstIndex = 0;  // Индекс первого индекса меша в буфере индексов
+		GLsizei indexCount = 0;
+		uint32_t id = 0;        // Порядковый номер меша в арене
+
+		/// @return Смещение первого индекса в байтах, в виде, который принимает glDrawElements*
+		const void* getIndexOffset() const noexcept {
+			return reinterpret_cast<const void*>(size_t(firstIndex) * sizeof(GLuint));
+		}
+	};
+
+
+	/**
+	 * @brief Общие буферы вершин и индексов для всех статических мешей одного формата вершин.
+	 * Модели запрашивают меши при создании, каждый файл становится отдельным ресурсом (Asset),
+	 * который загружается на этапе загрузки ресурсов. Меш читается из бинарного кэша (см. mesh_cache),
+	 * и только если кэша нет или исходный файл изменился, файл разбирается, а кэш пересоздаётся.
+	 * При создании VAO первой модели все меши арены загружаются в один VBO и один EBO.
+	 * Все меши арены рисуются через один VAO с помощью glDrawElementsBaseVertex,
+	 * поэтому между моделями одного формата VAO не переключается.
+	 * Меш хранится один раз, даже если файл используется несколькими моделями.
+	 * После загрузки в видеопамять копия данных в оперативной памяти освобождается.
+	 */
+	class MeshArena {
+	public:
+		/// Разбирает файл меша в вершины (в виде байтов) и индексы, отсчитываемые от первой вершины меша
+		using Parser = std::function<void(const std::string& path, std::vector<uint8_t>& vertexData, std::vector<GLuint>& indices)>;
+
+	private:
+		class Entry;
+
+		const char* const format; // Название формата вершин, входит в имя файла кэша
+		const size_t vertexSize;
+		void (* const setupAttributes)(); // Настраивает атрибуты вершин для привязанных VAO и VBO
+		const Parser parser;
+
+		std::vector<std::unique_ptr<Entry>> entries;
+		std::map<std::string, Entry*> entriesByPath;
+
+		GLuint vertexArray = 0;
+
+	public:
+		/// @param parse разбирает файл меша в вершины типа Vertex и индексы
+		template<typename Vertex>
+		MeshArena(const char* format, void (*setupAttributes)(),
+				void (*parse)(const std::string& path, std::vector<Vertex>&, std::vector<GLuint>&)):
+			MeshArena(format, sizeof(Vertex), setupAttributes,
+				[parse] (const std::string& path, std::vector<uint8_t>& vertexData, std::vector<GLuint>& indices) {
+					std::vector<Vertex> vertices;
+					parse(path, vertices, indices);
+
+					vertexData.resize(vertices.size() * sizeof(Vertex));
+					std::memcpy(vertexData.data(), vertices.data(), vertexData.size());
+				}) {}
+
+		MeshArena(const char* format, size_t vertexSize, void (*setupAttributes)(), Parser parser);
+		~MeshArena();
+
+		MeshArena(const MeshArena&) = delete;
+		MeshArena& operator=(const MeshArena&) = delete;
+
+		/**
+		 * @brief Запрашивает меш из файла path. Файл не открывается, а добавляется в манифест ресурсов.
+		 * Если файл уже запрошен, возвращается тот же меш
+		 * @return Меш. Поля, кроме id, заполняются при upload
+		 */
+		const Mesh& request(const std::string& path);
+
+		/// @brief Загружает арену в видеопамять, если она ещё не загружена. Все меши уже должны быть загружены с диска
+		/// @return VAO арены
+		GLuint upload();
+
+		GLuint getVertexArray() const noexcept {
+			return vertexArray;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,120 @@
+#include "mesh_cache.h"
+#include "mapped_file.h"
+#include "dir_paths.h"
+#include "util.h"
+
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+
+namespace hack_game {
+	namespace mesh_cache {
+		using std::string;
+		using std::ofstream;
+		using std::optional;
+		using std::nullopt;
+
+		namespace fs = std::filesystem;
+
+		static constexpr uint32_t MAGIC = 0x48534D48; // "HMSH"
+		static constexpr uint32_t VERSION = 1;
+
+		struct Header {
+			uint32_t magic;
+			uint32_t version;
+			uint64_t sourceHash;
+			uint32_t vertexSize;
+			uint32_t vertexCount;
+			uint32_t indexCount;
+			uint32_t reserved;
+		};
+
+		// Вершины и индексы идут сразу после заголовка, поэтому он не должен нарушать их выравнивание
+		static_assert(sizeof(Header) % sizeof(float) == 0);
+
+
+		string getCachePath(const string& sourcePath, const char* format) {
+			const string relativePath = sourcePath.starts_with(MODELS_DIR) ?
+					sourcePath.substr(std::size(MODELS_DIR) - 1) :
+					sourcePath;
+
+			return MESH_CACHE_DIR + relativePath + '.' + format + ".mesh";
+		}
+
+
+		optional<uint64_t> hashSource(const string& sourcePath) {
+			const MappedFile file(sourcePath);
+
+			if (!file.isOpen()) {
+				return nullopt;
+			}
+
+			return hashFnv1a(file.getData(), file.getSize());
+		}
+
+
+		optional<MeshData> load(const MappedFile& cacheFile, uint64_t sourceHash, size_t vertexSize) {
+			if (!cacheFile.isOpen() || cacheFile.getSize() < sizeof(Header)) {
+				return nullopt;
+			}
+
+			Header header;
+			std::memcpy(&header, cacheFile.getData(), sizeof(header));
+
+			if (header.magic != MAGIC || header.version != VERSION ||
+				header.sourceHash != sourceHash || header.vertexSize != vertexSize) {
+				return nullopt;
+			}
+
+			const size_t verticesSize = size_t(header.vertexCount) * vertexSize;
+
+			if (cacheFile.getSize() != sizeof(Header) + verticesSize + header.indexCount * sizeof(GLuint)) {
+				return nullopt;
+			}
+
+			const uint8_t* vertices = cacheFile.getData() + sizeof(Header);
+
+			return MeshData {
+				.vertices = vertices,
+				.verticesSize = verticesSize,
+				.indices = reinterpret_cast<const GLuint*>(vertices + verticesSize),
+				.indexCount = header.indexCount,
+			};
+		}
+
+
+		void save(const string& cachePath, uint64_t sourceHash, size_t vertexSize, const MeshData& data) {
+			std::error_code error;
+			fs::create_directories(fs::path(cachePath).parent_path(), error);
+
+			const Header header {
+				.magic = MAGIC,
+				.version = VERSION,
+				.sourceHash = sourceHash,
+				.vertexSize = uint32_t(vertexSize),
+				.vertexCount = uint32_t(data.verticesSize / vertexSize),
+				.indexCount = uint32_t(data.indexCount),
+				.reserved = 0,
+			};
+
+			// Файл пишется во временный и затем переименовывается, чтобы не оставить недописанный кэш
+			const string tempPath = cachePath + ".tmp";
+
+			{
+				ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+
+				file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				file.write(static_cast<const char*>(data.vertices), std::streamsize(data.verticesSize));
+				file.write(reinterpret_cast<const char*>(data.indices), std::streamsize(data.indexCount * sizeof(GLuint)));
+
+				if (!file) {
+					file.close();
+					fs::remove(tempPath, error);
+					return;
+				}
+			}
+
+			fs::rename(tempPath, cachePath, error);
+		}
+	}
+}
@@ -0,0 +1,47 @@
+#ifndef HACK_GAME__MODEL__MESH_CACHE_H
+#define HACK_GAME__MODEL__MESH_CACHE_H
+
+#include "gl_fwd.h"
+#include <string>
+#include <cstdint>
+#include <optional>
+
+namespace hack_game {
+
+	class MappedFile;
+
+	/**
+	 * @brief Бинарный кэш мешей. Файл кэша содержит уже склеенные вершины в том виде, в котором они лежат
+	 * в буфере вершин, и индексы, так что при загрузке файл не разбирается, а просто копируется.
+	 * В заголовке хранится хэш исходного файла .obj: если исходный файл изменился, кэш считается устаревшим.
+	 * Раскладка файла: | заголовок | вершины | индексы |
+	 */
+	namespace mesh_cache {
+
+		/// Данные меша в памяти
+		struct MeshData {
+			const void* vertices;
+			size_t verticesSize;   // Размер вершин в байтах
+			const GLuint* indices;
+			size_t indexCount;
+		};
+
+		/// @return Путь к файлу кэша для меша из файла sourcePath с форматом вершин format
+		std::string getCachePath(const std::string& sourcePath, const char* format);
+
+		/// @return Хэш содержимого файла или std::nullopt, если файл не удалось прочитать
+		std::optional<uint64_t> hashSource(const std::string& sourcePath);
+
+		/**
+		 * @brief Читает меш из файла кэша, если кэш построен из исходного файла с хэшем sourceHash
+		 * и с тем же размером вершины
+		 * @return Данные меша, указывающие в память cacheFile, или std::nullopt, если кэша нет или он устарел
+		 */
+		std::optional<MeshData> load(const MappedFile& cacheFile, uint64_t sourceHash, size_t vertexSize);
+
+		/// @brief Записывает меш в файл кэша. Ошибки записи игнорируются, так как без кэша игра всё равно работает
+		void save(const std::string& cachePath, uint64_t sourceHash, size_t vertexSize, const MeshData& data);
+	}
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "gl_fwd.h"
 #include <vector>
+#include <cstdint>
 #include <glm/vec3.hpp>
 
 namespace hack_game {
@@ -26,6 +27,21 @@ namespace hack_game {
 
 		virtual void generateVertexArray() = 0;
 		virtual void draw(Shader&) const = 0;
+
+		/// @return VAO модели или 0, если у модели нет одного VAO. Используется для сортировки команд отрисовки
+		virtual GLuint getVertexArray() const noexcept {
+			return 0;
+		}
+
+		/// @return Номер меша модели внутри её VAO или 0. Используется для сортировки и объединения команд отрисовки
+		virtual uint32_t getMeshId() const noexcept {
+			return 0;
+		}
+
+		/// @return Основную текстуру модели или 0, если её нет. Используется для сортировки команд отрисовки
+		virtual GLuint getTexture() const noexcept {
+			return 0;
+		}
 	};
 }
 
@@ -39,8 +39,8 @@ namespace hack_game {
 		};
 
 		static TexturedModel texturedModels[] = {
-			TexturedModel("plane.obj", {"enemy-destroy-1.png", "enemy-destroy-2.png", "enemy-destroy-3.png"}),
-			TexturedModel("plane.obj", {"minion-destroy-1.png", "minion-destroy-2.png", "minion-destroy-3.png"}),
+			TexturedModel("plane.obj", {"enemy-destroy-1.tex", "enemy-destroy-2.tex", "enemy-destroy-3.tex"}),
+			TexturedModel("plane.obj", {"minion-destroy-1.tex", "minion-destroy-2.tex", "minion-destroy-3.tex"}),
 		};
 
 		static PostprocessingModel postprocessingModels[] = {
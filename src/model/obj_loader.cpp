@@ -0,0 +1,320 @@
+#include "obj_loader.h"
+#include "mapped_file.h"
+
+#include <cstring>
+#include <charconv>
+#include <ios>
+#include <stdexcept>
+#include <string_view>
+
+namespace hack_game {
+	namespace obj_loader {
+		using std::string;
+		using std::string_view;
+		using std::vector;
+		using std::to_string;
+
+		using glm::vec2;
+		using glm::vec3;
+
+
+		/// @brief Разбирает текст файла, отображённого в память, не копируя его
+		class Scanner {
+			const char* pos;
+			const char* const end;
+			const string& path;
+			size_t line = 1;
+
+		public:
+			Scanner(const char* begin, const char* end, const string& path) noexcept:
+					pos(begin), end(end), path(path) {}
+
+			bool atEnd() const noexcept {
+				return pos >= end;
+			}
+
+			/// @return true, если в текущей строке больше ничего нет, кроме пробелов и комментария
+			bool atLineEnd() noexcept {
+				skipSpaces();
+				return pos >= end || *pos == '\n' || *pos == '#';
+			}
+
+			/// @brief Пропускает остаток текущей строки
+			void nextLine() noexcept {
+				const void* found = std::memchr(pos, '\n', end - pos);
+				pos = found != nullptr ? static_cast<const char*>(found) + 1 : end;
+				line += 1;
+			}
+
+			string_view readWord() noexcept {
+				skipSpaces();
+				const char* start = pos;
+
+				while (pos < end && *pos != ' ' && *pos != '\t' && *pos != '\r' && *pos != '\n') {
+					pos++;
+				}
+
+				return string_view(start, pos - start);
+			}
+
+			float readFloat() {
+				skipSpaces();
+
+				if (pos < end && *pos == '+') {
+					pos++;
+				}
+
+				float value;
+				const auto [next, error] = std::from_chars(pos, end, value);
+
+				if (error != std::errc()) {
+					throwError("expected a number");
+				}
+
+				pos = next;
+				return value;
+			}
+
+			int64_t readInt() {
+				int64_t value;
+				const auto [next, error] = std::from_chars(pos, end, value);
+
+				if (error != std::errc()) {
+					throwError("expected an index");
+				}
+
+				pos = next;
+				return value;
+			}
+
+			/// @return true, если следующий символ равен c. В этом случае символ пропускается
+			bool consume(char c) noexcept {
+				if (pos < end && *pos == c) {
+					pos++;
+					return true;
+				}
+
+				return false;
+			}
+
+			[[noreturn]] void throwError(const string& message) const {
+				throw std::invalid_argument("File '" + path + "', line " + to_string(line) + ": " + message);
+			}
+
+		private:
+			void skipSpaces() noexcept {
+				while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r')) {
+					pos++;
+				}
+			}
+		};
+
+
+		/// @brief Хэш-таблица с открытой адресацией и линейным пробированием. Ключ - вершина, значение - её индекс
+		class VertexTable {
+			static constexpr uint32_t EMPTY = UINT32_MAX;
+
+			struct Slot {
+				ObjVertex vertex;
+				uint32_t index = EMPTY;
+			};
+
+			vector<Slot> slots = vector<Slot>(1024);
+
+		public:
+			/// @return Индекс вершины в vertices. Если такой вершины ещё нет, она добавляется в конец vertices
+			uint32_t insert(const ObjVertex& vertex, vector<ObjVertex>& vertices) {
+				// Таблица заполняется не больше, чем наполовину, чтобы цепочки пробирования оставались короткими
+				if (vertices.size() * 2 >= slots.size()) {
+					grow(vertices);
+				}
+
+				Slot& slot = findSlot(vertex);
+
+				if (slot.index == EMPTY) {
+					slot.vertex = vertex;
+					slot.index = vertices.size();
+					vertices.push_back(vertex);
+				}
+
+				return slot.index;
+			}
+
+		private:
+			static size_t hash(const ObjVertex& vertex) noexcept {
+				uint64_t hash = uint64_t(vertex.position) * 0x9E3779B97F4A7C15 ^
+				                uint64_t(vertex.texCoord) * 0xC2B2AE3D27D4EB4F ^
+				                uint64_t(vertex.normal)   * 0x165667B19E3779F9;
+
+				return hash ^ (hash >> 32);
+			}
+
+			static bool equals(const ObjVertex& a, const ObjVertex& b) noexcept {
+				return a.position == b.position && a.texCoord == b.texCoord && a.normal == b.normal;
+			}
+
+			Slot& findSlot(const ObjVertex& vertex) noexcept {
+				const size_t mask = slots.size() - 1;
+
+				for (size_t i = hash(vertex) & mask;; i = (i + 1) & mask) {
+					Slot& slot = slots[i];
+
+					if (slot.index == EMPTY || equals(slot.vertex, vertex)) {
+						return slot;
+					}
+				}
+			}
+
+			void grow(const vector<ObjVertex>& vertices) {
+				slots.assign(slots.size() * 2, Slot());
+
+				for (size_t i = 0; i < vertices.size(); i++) {
+					Slot& slot = findSlot(vertices[i]);
+					slot.vertex = vertices[i];
+					slot.index = i;
+				}
+			}
+		};
+
+
+		/// @return Индекс атрибута, начиная с 0. Отрицательный индекс отсчитывается от последнего прочитанного атрибута
+		static uint32_t resolveIndex(Scanner& scanner, int64_t index, size_t count, const char* attribute) {
+			const int64_t resolved = index > 0 ? index - 1 : int64_t(count) + index;
+
+			if (index == 0 || resolved < 0 || resolved >= int64_t(count)) {
+				scanner.throwError(string("invalid ") + attribute + " index " + to_string(index));
+			}
+
+			return uint32_t(resolved);
+		}
+
+		/// @brief Читает вершину грани или ломаной в одной из форм v, v/vt, v//vn, v/vt/vn и склеивает её с такими же
+		/// @return Индекс склеенной вершины
+		static uint32_t readVertex(Scanner& scanner, ObjMesh& mesh, VertexTable& table, uint32_t flags, bool isLine) {
+			ObjVertex vertex {0, 0, 0};
+			bool hasTexCoord = false, hasNormal = false;
+
+			vertex.position = resolveIndex(scanner, scanner.readInt(), mesh.positions.size(), "position");
+
+			if (scanner.consume('/')) {
+				bool hasNormalSlash = scanner.consume('/');
+
+				if (!hasNormalSlash) {
+					const uint32_t texCoord = resolveIndex(scanner, scanner.readInt(), mesh.texCoords.size(), "texture coordinate");
+					hasTexCoord = true;
+
+					if (flags & TEX_COORDS) {
+						vertex.texCoord = texCoord;
+					}
+
+					hasNormalSlash = scanner.consume('/');
+				}
+
+				if (hasNormalSlash) {
+					const uint32_t normal = resolveIndex(scanner, scanner.readInt(), mesh.normals.size(), "normal");
+					hasNormal = true;
+
+					if (flags & NORMALS) {
+						vertex.normal = normal;
+					}
+				}
+			}
+
+			if ((flags & TEX_COORDS) && !hasTexCoord) {
+				scanner.throwError("vertex has no texture coordinate");
+			}
+
+			// У ломаных нет нормалей, поэтому они от них не требуются
+			if ((flags & NORMALS) && !hasNormal && !isLine) {
+				scanner.throwError("vertex has no normal");
+			}
+
+			return table.insert(vertex, mesh.vertices);
+		}
+
+
+		ObjMesh load(const string& path, uint32_t flags) {
+			const MappedFile file(path);
+
+			if (!file.isOpen()) {
+				throw std::ios_base::failure("Cannot open file '" + path + "'");
+			}
+
+			const char* data = reinterpret_cast<const char*>(file.getData());
+			Scanner scanner(data, data + file.getSize(), path);
+
+			ObjMesh mesh;
+			VertexTable table;
+			vector<GLuint> polygon; // Вершины текущей грани или ломаной
+
+			for (; !scanner.atEnd(); scanner.nextLine()) {
+				const string_view tag = scanner.readWord();
+
+				if (tag == "v") {
+					const float x = scanner.readFloat();
+					const float y = scanner.readFloat();
+					const float z = scanner.readFloat();
+					mesh.positions.emplace_back(x, y, z);
+					continue;
+				}
+
+				if (tag == "vt") {
+					const float u = scanner.readFloat();
+					const float v = scanner.readFloat();
+					mesh.texCoords.emplace_back(u, v);
+					continue;
+				}
+
+				if (tag == "vn") {
+					const float x = scanner.readFloat();
+					const float y = scanner.readFloat();
+					const float z = scanner.readFloat();
+					mesh.normals.emplace_back(x, y, z);
+					continue;
+				}
+
+				if (tag == "f" || tag == "l") {
+					const bool isLine = tag == "l";
+
+					polygon.clear();
+
+					while (!scanner.atLineEnd()) {
+						polygon.push_back(readVertex(scanner, mesh, table, flags, isLine));
+					}
+
+					if (isLine) {
+						if (polygon.size() < 2) {
+							scanner.throwError("line has less than 2 vertices");
+						}
+
+						for (size_t i = 1; i < polygon.size(); i++) {
+							mesh.lines.push_back(polygon[i - 1]);
+							mesh.lines.push_back(polygon[i]);
+						}
+
+						continue;
+					}
+
+					if (polygon.size() < 3) {
+						scanner.throwError("face has less than 3 vertices");
+					}
+
+					if (polygon.size() > 3 && !(flags & TRIANGULATE)) {
+						scanner.throwError("face has more than 3 vertices");
+					}
+
+					// Веер из первой вершины. Для треугольника это он сам
+					for (size_t i = 2; i < polygon.size(); i++) {
+						mesh.triangles.push_back(polygon[0]);
+						mesh.triangles.push_back(polygon[i - 1]);
+						mesh.triangles.push_back(polygon[i]);
+					}
+
+					continue;
+				}
+			}
+
+			return mesh;
+		}
+	}
+}
@@ -0,0 +1,55 @@
+#ifndef HACK_GAME__MODEL__OBJ_LOADER_H
+#define HACK_GAME__MODEL__OBJ_LOADER_H
+
+#include "gl_fwd.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+namespace hack_game {
+
+	/**
+	 * @brief Общий загрузчик файлов .obj для всех моделей. Файл отображается в память и разбирается за один проход
+	 * без копирования строк. Вершины граней склеиваются через хэш-таблицу с открытой адресацией,
+	 * так что время загрузки растёт линейно от размера файла.
+	 * Поддерживаются v, vt, vn, f и l, отрицательные (относительные) индексы и все формы вершин грани:
+	 * v, v/vt, v//vn и v/vt/vn. Остальные строки пропускаются
+	 */
+	namespace obj_loader {
+
+		enum Flags: uint32_t {
+			TEX_COORDS  = 1 << 0, // Вершины различаются текстурными координатами. Каждая вершина грани должна их иметь
+			NORMALS     = 1 << 1, // Вершины различаются нормалями. Каждая вершина грани должна их иметь
+			TRIANGULATE = 1 << 2, // Разбивать многоугольники на треугольники веером. Без этого флага многоугольник - ошибка
+		};
+
+		/// Склеенная вершина: индексы атрибутов в ObjMesh. Индекс атрибута, который не запрошен флагами, равен 0
+		struct ObjVertex {
+			uint32_t position;
+			uint32_t texCoord;
+			uint32_t normal;
+		};
+
+		struct ObjMesh {
+			std::vector<glm::vec3> positions;
+			std::vector<glm::vec2> texCoords;
+			std::vector<glm::vec3> normals;
+
+			std::vector<ObjVertex> vertices;
+			std::vector<GLuint> triangles; // Индексы в vertices, по три на треугольник
+			std::vector<GLuint> lines;     // Индексы в vertices, по два на отрезок. Ломаные разбиваются на отрезки
+		};
+
+		/**
+		 * @brief Загружает файл .obj
+		 * @param flags комбинация Flags
+		 * @throw std::ios_base::failure если файл не удалось открыть
+		 * @throw std::invalid_argument если файл содержит ошибку
+		 */
+		ObjMesh load(const std::string& path, uint32_t flags);
+	}
+}
+
+#endif
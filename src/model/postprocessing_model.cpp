@@ -1,11 +1,22 @@
 #include "postprocessing_model.h"
 #include "debug.h"
+#include "render/gl_state.h"
+
+#include <iterator>
 
 #define GLEW_STATIC
 #include <GL/glew.h>
 
 namespace hack_game {
 
+	static constexpr GLuint indices[] = {
+		2, 1, 0,
+		1, 2, 3,
+	};
+
+	// У прямоугольника собственный VAO, поэтому меш занимает весь буфер
+	static constexpr Mesh quadMesh { .indexCount = std::size(indices) };
+
 	struct PostprocessingModel::Vertex {
 		const glm::vec2 pos;
 		const glm::vec2 texCoord;
@@ -19,10 +30,7 @@ namespace hack_game {
 				Vertex { .pos { 1,  1}, .texCoord {1, 1} },
 			} {
 		
-		indices = {
-			2, 1, 0,
-			1, 2, 3,
-		};
+		mesh = &quadMesh;
 	}
 
 	PostprocessingModel::~PostprocessingModel() {}
@@ -35,13 +43,13 @@ namespace hack_game {
 		glGenVertexArrays(1, &VAO);
 		
 		
-		glBindVertexArray(VAO);
+		gl_state::bindVertexArray(VAO);
 
 		glBindBuffer(GL_ARRAY_BUFFER, VBO);	
 		glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(vertices.size() * sizeof(vertices[0])), vertices.data(), GL_STATIC_DRAW);
 
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);	
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, GLsizeiptr(indices.size() * sizeof(indices[0])), indices.data(), GL_STATIC_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, GLsizeiptr(sizeof(indices)), indices, GL_STATIC_DRAW);
 
 		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<GLvoid*>(offsetof(Vertex, pos)));
 		glEnableVertexAttribArray(0);
@@ -49,7 +57,7 @@ namespace hack_game {
 		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<GLvoid*>(offsetof(Vertex, texCoord)));
 		glEnableVertexAttribArray(1);
 		
-		glBindVertexArray(0);
+		gl_state::bindVertexArray(0);
 		return VAO;
 	}
 }
\ No newline at end of file
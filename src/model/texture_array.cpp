@@ -0,0 +1,134 @@
+#include "texture_array.h"
+#include "texture.h"
+#include "asset/asset.h"
+#include "render/gl_state.h"
+
+#include <cassert>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+namespace hack_game {
+	using std::string;
+	using std::vector;
+
+	using texture_file::TextureData;
+	using texture_file::getLevelSize;
+
+	static const float BORDER_COLOR[] = {0, 0, 0, 0};
+
+	/// Кадр. Читается в рабочем потоке и хранится до загрузки массива в видеопамять
+	class TextureArray::Frame: public Asset {
+		const string path;
+
+	public:
+		std::optional<Texture> texture;
+
+		explicit Frame(const string& path):
+				path(path) {}
+
+		const string& getPath() const noexcept override {
+			return path;
+		}
+
+		void load() override {
+			texture.emplace(path.c_str());
+		}
+	};
+
+
+	TextureArray::TextureArray() {}
+	TextureArray::~TextureArray() {}
+
+
+	GLint TextureArray::request(const vector<string>& paths) {
+		assert(texture == 0 && "Frames requested after the texture array was uploaded");
+
+		const GLint firstLayer = GLint(frames.size());
+
+		for (const string& path : paths) {
+			frames.push_back(std::make_unique<Frame>(path));
+		}
+
+		return firstLayer;
+	}
+
+
+	GLuint TextureArray::upload() {
+		if (texture != 0 || frames.empty()) {
+			return texture;
+		}
+
+		for (const std::unique_ptr<Frame>& frame : frames) {
+			assert(frame->texture.has_value() && "Texture array uploaded before its frames were loaded");
+		}
+
+		const TextureData& first = frames[0]->texture->getData();
+
+		for (const std::unique_ptr<Frame>& frame : frames) {
+			const TextureData& data = frame->texture->getData();
+
+			if (data.format != first.format || data.width != first.width || data.height != first.height || data.levelCount != first.levelCount) {
+				throw std::invalid_argument("Frame '" + frame->getPath() + "' differs in size or format from frame '" + frames[0]->getPath() + "'");
+			}
+		}
+
+		glGenTextures(1, &texture);
+		gl_state::bindTextureArray(0, texture);
+
+		const GLenum internalFormat = texture_file::getInternalFormat(first.format);
+		const GLsizei layers = GLsizei(frames.size());
+
+		size_t levelOffset = 0;
+		vector<uint8_t> levelData;
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		// Уровень загружается сразу для всех слоёв, поэтому данные слоёв склеиваются
+		for (GLint level = 0; level < first.levelCount; level++) {
+			const GLsizei width = getLevelSize(first.width, level);
+			const GLsizei height = getLevelSize(first.height, level);
+			const size_t size = texture_file::getDataSize(first.format, width, height);
+
+			levelData.resize(size * frames.size());
+
+			for (size_t i = 0; i < frames.size(); i++) {
+				std::memcpy(levelData.data() + i * size, frames[i]->texture->getData().levels + levelOffset, size);
+			}
+
+			if (texture_file::isCompressed(first.format)) {
+				glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, internalFormat, width, height, layers, 0,
+						GLsizei(levelData.size()), levelData.data());
+			} else {
+				glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GLint(internalFormat), width, height, layers, 0,
+						texture_file::getPixelFormat(first.format), GL_UNSIGNED_BYTE, levelData.data());
+			}
+
+			levelOffset += size;
+		}
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+		GLint swizzle[4];
+		texture_file::getSwizzle(first.format, swizzle);
+
+		glTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, first.levelCount - 1);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+		glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, BORDER_COLOR);
+
+		gl_state::bindTextureArray(0, 0);
+
+		for (const std::unique_ptr<Frame>& frame : frames) {
+			frame->texture.reset();
+		}
+
+		return texture;
+	}
+}
@@ -0,0 +1,50 @@
+#ifndef HACK_GAME__MODEL__TEXTURE_ARRAY_H
+#define HACK_GAME__MODEL__TEXTURE_ARRAY_H
+
+#include "gl_fwd.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hack_game {
+
+	/**
+	 * @brief Общий массив текстур (GL_TEXTURE_2D_ARRAY) для кадров анимаций. Модели запрашивают кадры при создании,
+	 * каждое изображение становится отдельным ресурсом (Asset). Все слои массива одного размера и формата,
+	 * поэтому texture_converter приводит все кадры к одному размеру (см. TEXTURE_FRAMES в CMakeLists.txt).
+	 * Все модели с кадрами из массива используют одну привязку текстуры
+	 */
+	class TextureArray {
+		class Frame;
+
+		std::vector<std::unique_ptr<Frame>> frames;
+		GLuint texture = 0;
+
+	public:
+		TextureArray();
+		~TextureArray();
+
+		TextureArray(const TextureArray&) = delete;
+		TextureArray& operator=(const TextureArray&) = delete;
+
+		/**
+		 * @brief Запрашивает кадры из файлов paths. Файлы не открываются, а добавляются в манифест ресурсов.
+		 * Кадры занимают подряд идущие слои массива
+		 * @return Номер слоя первого кадра
+		 */
+		GLint request(const std::vector<std::string>& paths);
+
+		/**
+		 * @brief Загружает массив в видеопамять, если он ещё не загружен. Все кадры уже должны быть загружены с диска
+		 * @return ID объекта текстуры
+		 * @throw std::invalid_argument если кадры различаются размером или форматом
+		 */
+		GLuint upload();
+
+		GLuint getTexture() const noexcept {
+			return texture;
+		}
+	};
+}
+
+#endif
@@ -2,20 +2,17 @@
 #define HACK_GAME__MODEL__TEXTURED_MODEL_H
 
 #include "vao_model.h"
+#include "texture_array.h"
 #include <glm/vec2.hpp>
 
 namespace hack_game {
 
-	class Texture;
-
 	class TexturedModel: public VAOModel {
 	public:
 		struct Vertex;
 
 	private:
-		std::vector<Texture> textures;
-		std::vector<GLuint> textureIds;
-		std::vector<Vertex> vertices;
+		GLint firstFrame; // Слой первого кадра модели в общем массиве текстур
 
 	public:
 		TexturedModel(const char* relativeModelPath, std::initializer_list<const char*> relativeTexturePaths);
@@ -23,8 +20,19 @@ namespace hack_game {
 
 		void draw(Shader&) const override;
 
+		GLuint getTexture() const noexcept override {
+			return getFrames().getTexture();
+		}
+
 	protected:
 		GLuint createVertexArray() override;
+	
+	private:
+		/// @return Общую арену мешей всех текстурированных моделей
+		static MeshArena& getArena();
+
+		/// @return Общий массив кадров всех текстурированных моделей
+		static TextureArray& getFrames();
 	};
 }
 
@@ -1,27 +1,58 @@
 #include "vao_model.h"
+#include "render/instance_buffer.h"
+#include "render/gl_state.h"
 #include "util.h"
 
+#include <map>
+
 #define GLEW_STATIC
 #include <GL/glew.h>
 
 namespace hack_game {
+	using std::map;
+
 	using glm::vec3;
 
 	VAOModel::VAOModel() noexcept {}
 
 	VAOModel::VAOModel(const VAOModel& model):
-			indices(model.indices),
+			mesh(model.mesh),
 			vertexArray(model.vertexArray) {}
 
 	void VAOModel::generateVertexArray() {
 		vertexArray = createVertexArray();
 	}
 
-	void VAOModel::draw(Shader&) const {
+	void VAOModel::bindVertexArray() const noexcept {
 		assert(vertexArray != 0);
+		gl_state::bindVertexArray(vertexArray);
+	}
+
+	GLenum VAOModel::getPrimitiveType() const noexcept {
+		return GL_TRIANGLES;
+	}
+
+	void VAOModel::draw(Shader&) const {
+		bindVertexArray();
+		glDrawElementsBaseVertex(getPrimitiveType(), mesh->indexCount, GL_UNSIGNED_INT, mesh->getIndexOffset(), mesh->baseVertex);
+		gl_state::addDrawCall();
+	}
+
+	// Ключ: VAO, значение: буфер экземпляров, атрибуты которого подключены к этому VAO.
+	// VAO общий для всех моделей арены, поэтому подключение запоминается для VAO, а не для модели
+	static map<GLuint, GLuint> instanceBuffers;
+
+	void VAOModel::drawInstanced(const InstanceBuffer& buffer, GLsizei count) const {
+		bindVertexArray();
+
+		GLuint& instanceBuffer = instanceBuffers[vertexArray];
+
+		if (instanceBuffer != buffer.getId()) {
+			buffer.bindAttributes();
+			instanceBuffer = buffer.getId();
+		}
 
-		glBindVertexArray(vertexArray);
-		glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, nullptr);
-		glBindVertexArray(0);
+		glDrawElementsInstancedBaseVertex(getPrimitiveType(), mesh->indexCount, GL_UNSIGNED_INT, mesh->getIndexOffset(), count, mesh->baseVertex);
+		gl_state::addDrawCall();
 	}
 }
\ No newline at end of file
@@ -2,12 +2,15 @@
 #define HACK_GAME__MODEL__VAO_MODEL_H
 
 #include "model.h"
+#include "mesh_arena.h"
 
 namespace hack_game {
 
+	class InstanceBuffer;
+
 	class VAOModel: public Model {
 	protected:
-		std::vector<GLuint> indices;
+		const Mesh* mesh = nullptr; // Меш в арене. Заполняется полностью только после загрузки арены в видеопамять
 		GLuint vertexArray = 0;
 	
 	public:
@@ -16,9 +19,29 @@ namespace hack_game {
 
 		void generateVertexArray() override;
 		void draw(Shader&) const override;
+
+		/// @brief Рисует count экземпляров модели за один вызов glDrawElementsInstanced.
+		/// Атрибуты экземпляров должны быть уже загружены в буфер (InstanceBuffer::upload)
+		void drawInstanced(const InstanceBuffer&, GLsizei count) const;
+
+		GLuint getVertexArray() const noexcept override {
+			return vertexArray;
+		}
+
+		uint32_t getMeshId() const noexcept override {
+			return mesh != nullptr ? mesh->id : 0;
+		}
 	
 	protected:
+		/// @return VAO, в котором находится меш модели. Модели одного формата вершин используют общий VAO арены
 		virtual GLuint createVertexArray() = 0;
+
+		/// @return Тип примитивов, из которых состоит модель. По умолчанию GL_TRIANGLES
+		virtual GLenum getPrimitiveType() const noexcept;
+
+		/// @brief Привязывает VAO модели, если он ещё не привязан. После отрисовки VAO не отвязывается,
+		/// поэтому подряд идущие отрисовки одной модели не вызывают лишних glBindVertexArray
+		void bindVertexArray() const noexcept;
 	};
 }
 
@@ -0,0 +1,51 @@
+#include "random.h"
+
+namespace hack_game {
+	using glm::vec3;
+
+	static uint64_t splitMix64(uint64_t& x) noexcept {
+		uint64_t z = (x += 0x9E3779B97F4A7C15);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+		return z ^ (z >> 31);
+	}
+
+	void Random::setSeed(uint64_t seed) noexcept {
+		for (int i = 0; i < 4; i += 2) {
+			const uint64_t value = splitMix64(seed);
+			state[i]     = static_cast<uint32_t>(value);
+			state[i + 1] = static_cast<uint32_t>(value >> 32);
+		}
+	}
+
+
+	// Пачка генерируется копией генератора: так состояние остаётся в регистрах на всю пачку,
+	// а не записывается в память после каждого числа
+	void Random::fillFloats(float* result, size_t count, float low, float high) noexcept {
+		Random local = *this;
+		const float scale = high - low;
+
+		for (size_t i = 0; i < count; i++) {
+			result[i] = low + local.nextFloat() * scale;
+		}
+
+		*this = local;
+	}
+
+	// Границы копируются, потому что result может указывать на low или high
+	void Random::fillVec3s(vec3* result, size_t count, const vec3& low, const vec3& high) noexcept {
+		const vec3 offset = low;
+		const vec3 scale = high - low;
+
+		Random local = *this;
+
+		for (size_t i = 0; i < count; i++) {
+			const float x = local.nextFloat();
+			const float y = local.nextFloat();
+			const float z = local.nextFloat();
+			result[i] = offset + vec3(x, y, z) * scale;
+		}
+
+		*this = local;
+	}
+}
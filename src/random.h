@@ -0,0 +1,83 @@
+#ifndef HACK_GAME__RANDOM_H
+#define HACK_GAME__RANDOM_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <glm/vec3.hpp>
+
+namespace hack_game {
+
+	/**
+	 * @brief Генератор псевдослучайных чисел xoshiro128**. Состояние - 16 байт, одно число - несколько сдвигов и умножений.
+	 * В отличие от rand(), не использует глобальное состояние и блокировки, поэтому у каждого уровня свой генератор,
+	 * и одно и то же зерно всегда даёт одну и ту же последовательность
+	 */
+	class Random {
+		uint32_t state[4];
+
+		static constexpr uint32_t rotl(uint32_t x, int k) noexcept {
+			return (x << k) | (x >> (32 - k));
+		}
+
+	public:
+		explicit Random(uint64_t seed = 0) noexcept {
+			setSeed(seed);
+		}
+
+		/// @brief Заполняет состояние из зерна через splitmix64. Любое зерно, в том числе 0, даёт рабочее состояние
+		void setSeed(uint64_t seed) noexcept;
+
+		uint32_t nextUint32() noexcept {
+			const uint32_t result = rotl(state[1] * 5, 7) * 9;
+			const uint32_t t = state[1] << 9;
+
+			state[2] ^= state[0];
+			state[3] ^= state[1];
+			state[1] ^= state[2];
+			state[0] ^= state[3];
+			state[2] ^= t;
+			state[3] = rotl(state[3], 11);
+
+			return result;
+		}
+
+		/// @brief Все 32 бита случайны
+		int32_t nextInt32() noexcept {
+			return static_cast<int32_t>(nextUint32());
+		}
+
+		/// @return Случайное число в диапазоне [low, high]. Обязательное условие: low <= high
+		int nextInt(int low, int high) noexcept {
+			assert(low <= high);
+			const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(high) - low) + 1;
+			return static_cast<int>(low + static_cast<int64_t>((nextUint32() * range) >> 32));
+		}
+
+		/// @return Случайное число в диапазоне [0, 1)
+		float nextFloat() noexcept {
+			return static_cast<float>(nextUint32() >> 8) * (1.0f / (1 << 24));
+		}
+
+		/// @return Случайное число в диапазоне [low, high)
+		float nextFloat(float low, float high) noexcept {
+			return low + nextFloat() * (high - low);
+		}
+
+		/// @return Случайный вектор, каждая компонента которого лежит в диапазоне [low, high)
+		glm::vec3 nextVec3(const glm::vec3& low, const glm::vec3& high) noexcept {
+			const float x = nextFloat(low.x, high.x);
+			const float y = nextFloat(low.y, high.y);
+			const float z = nextFloat(low.z, high.z);
+			return glm::vec3(x, y, z);
+		}
+
+		/// @brief Заполняет count чисел в диапазоне [low, high). Используется для частиц, которые создаются пачкой
+		void fillFloats(float* result, size_t count, float low, float high) noexcept;
+
+		/// @brief Заполняет count векторов в диапазоне [low, high)
+		void fillVec3s(glm::vec3* result, size_t count, const glm::vec3& low, const glm::vec3& high) noexcept;
+	};
+}
+
+#endif
@@ -0,0 +1,255 @@
+#include "draw_list.h"
+#include "shader/shader.h"
+#include "instance_buffer.h"
+#include "gpu_timer.h"
+#include "model/colored_model.h"
+
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace hack_game {
+
+	using glm::vec2;
+	using glm::vec3;
+	using glm::vec4;
+	using glm::mat4;
+
+	// ---------------------------------------- UniformList ----------------------------------------
+
+	UniformList::Value& UniformList::add(UniformId id, Type type) noexcept {
+		assert(count < CAPACITY);
+
+		Value& value = values[count++];
+		value.id = id;
+		value.type = type;
+		return value;
+	}
+
+	void UniformList::set(Uniform<float> uniform, float val) noexcept {
+		add(uniform.id, Type::FLOAT).floatValue.x = val;
+	}
+
+	void UniformList::set(Uniform<GLint> uniform, GLint val) noexcept {
+		add(uniform.id, Type::INT).intValue = val;
+	}
+
+	void UniformList::set(Uniform<vec2> uniform, const vec2& val) noexcept {
+		add(uniform.id, Type::VEC2).floatValue = vec3(val, 0.0f);
+	}
+
+	void UniformList::set(Uniform<vec3> uniform, const vec3& val) noexcept {
+		add(uniform.id, Type::VEC3).floatValue = val;
+	}
+
+	void UniformList::apply(Shader& shader) const {
+		for (size_t i = 0; i < count; i++) {
+			const Value& value = values[i];
+
+			switch (value.type) {
+				case Type::FLOAT: shader.setUniform(Uniform<float> { value.id }, value.floatValue.x); break;
+				case Type::INT:   shader.setUniform(Uniform<GLint> { value.id }, value.intValue); break;
+				case Type::VEC2:  shader.setUniform(Uniform<vec2>  { value.id }, vec2(value.floatValue)); break;
+				case Type::VEC3:  shader.setUniform(Uniform<vec3>  { value.id }, value.floatValue); break;
+			}
+		}
+	}
+
+
+	// ---------------------------------------- DrawCommand ----------------------------------------
+
+	// Раскладка ключа непрозрачной команды: | проход: 1 | шейдер: 12 | VAO: 6 | меш: 10 | текстура: 12 | глубина: 23 |
+	// Раскладка ключа прозрачной команды:   | проход: 1 | обратная глубина: 32 | 0: 31 |
+	static constexpr int PASS_SHIFT    = 63;
+	static constexpr int SHADER_SHIFT  = 51;
+	static constexpr int VAO_SHIFT     = 45;
+	static constexpr int MESH_SHIFT    = 35;
+	static constexpr int TEXTURE_SHIFT = 23;
+
+	static constexpr uint64_t SHADER_MASK  = (1 << 12) - 1;
+	static constexpr uint64_t VAO_MASK     = (1 << 6) - 1;
+	static constexpr uint64_t MESH_MASK    = (1 << 10) - 1;
+	static constexpr uint64_t TEXTURE_MASK = (1 << 12) - 1;
+
+
+	/// @return Биты глубины, упорядоченные так же, как и сама глубина. Отрицательная глубина считается нулевой
+	static uint32_t depthBits(float depth) noexcept {
+		// Проверка также отбрасывает -0.0 и NaN, у которых другой порядок битов
+		if (!(depth > 0.0f)) {
+			return 0;
+		}
+
+		// Для неотрицательных float порядок битового представления совпадает с порядком чисел
+		uint32_t bits;
+		std::memcpy(&bits, &depth, sizeof(bits));
+		return bits;
+	}
+
+	uint64_t DrawCommand::getSortKey(const mat4& view) const noexcept {
+		const float depth = -(view * transform[3]).z;
+
+		if (pass == RenderPass::TRANSPARENT) {
+			return uint64_t(1) << PASS_SHIFT | uint64_t(~depthBits(depth)) << 31;
+		}
+
+		return (uint64_t(shader->getId())          & SHADER_MASK)  << SHADER_SHIFT |
+		       (uint64_t(model->getVertexArray())  & VAO_MASK)     << VAO_SHIFT |
+		       (uint64_t(model->getMeshId())       & MESH_MASK)    << MESH_SHIFT |
+		       (uint64_t(model->getTexture())      & TEXTURE_MASK) << TEXTURE_SHIFT |
+		       depthBits(depth) >> 9;
+	}
+
+
+	/// @return Матрицу модели, интерполированную между предыдущим и текущим тиком
+	static mat4 getInterpolatedTransform(const DrawCommand& command, float tickProgress) {
+		// Модель сдвигается назад на ту часть смещения за тик, которая ещё не должна быть видна
+		const vec3 lag = command.tickOffset * (tickProgress - 1.0f);
+		return glm::translate(mat4(1.0f), lag) * command.transform;
+	}
+
+	void DrawCommand::execute(float tickProgress) const {
+		shader->setModel(getInterpolatedTransform(*this, tickProgress));
+
+		uniforms.apply(*shader);
+
+		if (brightness != 1.0f) {
+			shader->setUniform(uniform::modelBrightness, brightness);
+		}
+
+		if (color.has_value()) {
+			assert(dynamic_cast<const ColoredModel*>(model) != nullptr);
+			static_cast<const ColoredModel*>(model)->draw(*shader, *color);
+		} else {
+			model->draw(*shader);
+		}
+
+		if (brightness != 1.0f) {
+			shader->setUniform(uniform::modelBrightness, 1.0f);
+		}
+	}
+
+
+	// ----------------------------------------- DrawList ------------------------------------------
+
+	// Используются только потоком OpenGL, поэтому общие для всех очередей отрисовки
+	static InstanceBuffer instanceBuffer;
+	static std::vector<InstanceData> batchInstances;
+
+	/// @return true, если команду b можно нарисовать в одной инстансной отрисовке с командой a
+	static bool canBatch(const DrawCommand& a, const DrawCommand& b) noexcept {
+		return b.instanced && a.shader == b.shader &&
+				a.model->getVertexArray() == b.model->getVertexArray() &&
+				a.model->getMeshId() == b.model->getMeshId();
+	}
+
+	/// @brief Добавляет атрибуты экземпляра инстансной команды в batchInstances
+	static void addBatchInstance(const DrawCommand& command, float tickProgress) {
+		assert(dynamic_cast<const ColoredModel*>(command.model) != nullptr);
+		assert(command.uniforms.empty());
+
+		const vec3& color = command.color.has_value() ?
+				*command.color :
+				static_cast<const ColoredModel*>(command.model)->getColor();
+
+		batchInstances.push_back(InstanceData { getInterpolatedTransform(command, tickProgress), vec4(color * command.brightness, 1.0f) });
+	}
+
+
+	void DrawList::sort(const mat4& view) {
+		const size_t size = commands.size();
+		entries.resize(size);
+		sortBuffer.resize(size);
+
+		uint64_t allOr = 0, allAnd = ~uint64_t(0);
+
+		for (size_t i = 0; i < size; i++) {
+			const uint64_t key = commands[i].getSortKey(view);
+			entries[i] = Entry { key, static_cast<uint32_t>(i) };
+			allOr |= key;
+			allAnd &= key;
+		}
+
+		// Поразрядная сортировка по 8 бит, начиная с младших. Сортировка устойчивая, поэтому команды
+		// с одинаковыми ключами остаются в порядке записи. Разряды, одинаковые у всех ключей, пропускаются
+		const uint64_t differentBits = allOr ^ allAnd;
+
+		for (int shift = 0; shift < 64; shift += 8) {
+			if (((differentBits >> shift) & 0xFF) == 0) continue;
+
+			size_t offsets[256] = {};
+
+			for (const Entry& entry : entries) {
+				offsets[(entry.key >> shift) & 0xFF] += 1;
+			}
+
+			size_t total = 0;
+			for (size_t& offset : offsets) {
+				const size_t count = offset;
+				offset = total;
+				total += count;
+			}
+
+			for (const Entry& entry : entries) {
+				sortBuffer[offsets[(entry.key >> shift) & 0xFF]++] = entry;
+			}
+
+			entries.swap(sortBuffer);
+		}
+
+		transparentStart = std::partition_point(entries.begin(), entries.end(),
+				[] (const Entry& entry) { return (entry.key >> PASS_SHIFT) == 0; }) - entries.begin();
+	}
+
+
+	void DrawList::execute(RenderPass pass, float tickProgress) const {
+		assert(entries.size() == commands.size());
+
+		const size_t start = pass == RenderPass::OPAQUE ? 0 : transparentStart;
+		const size_t end   = pass == RenderPass::OPAQUE ? transparentStart : entries.size();
+
+		Shader* current = nullptr;
+
+		for (size_t i = start; i < end;) {
+			const DrawCommand& command = commands[entries[i].index];
+
+			if (command.shader != current) {
+				current = command.shader;
+				current->use();
+				gpu_timer::beginShader(current->getId());
+			}
+
+			batchInstances.clear();
+
+			if (command.instanceCount > 0) {
+				assert(command.uniforms.empty());
+
+				const mat4 lag = glm::translate(mat4(1.0f), command.tickOffset * (tickProgress - 1.0f));
+
+				for (uint32_t j = 0; j < command.instanceCount; j++) {
+					const InstanceData& instance = instances[command.instanceStart + j];
+					batchInstances.push_back(InstanceData { lag * instance.transform, instance.data });
+				}
+
+				i++;
+
+			} else if (command.instanced) {
+				for (; i < end && canBatch(command, commands[entries[i].index]); i++) {
+					addBatchInstance(commands[entries[i].index], tickProgress);
+				}
+
+			} else {
+				command.execute(tickProgress);
+				i++;
+				continue;
+			}
+
+			assert(dynamic_cast<const VAOModel*>(command.model) != nullptr);
+
+			instanceBuffer.upload(batchInstances);
+			static_cast<const VAOModel*>(command.model)->drawInstanced(instanceBuffer, batchInstances.size());
+		}
+
+		gpu_timer::endShader();
+	}
+}
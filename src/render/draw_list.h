@@ -0,0 +1,193 @@
+#ifndef HACK_GAME__RENDER__DRAW_LIST_H
+#define HACK_GAME__RENDER__DRAW_LIST_H
+
+#include "gl_fwd.h"
+#include "instance_buffer.h"
+#include "shader/uniforms.h"
+#include <vector>
+#include <optional>
+#include <cassert>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+
+namespace hack_game {
+
+	class Shader;
+	class Model;
+
+
+	/// Проход отрисовки. Прозрачные модели рисуются после непрозрачных, без записи в буфер глубины и с смешиванием цветов
+	enum class RenderPass: uint8_t {
+		OPAQUE, TRANSPARENT
+	};
+
+
+	/**
+	 * @brief Набор значений uniform-переменных для одной команды отрисовки.
+	 * Имеет фиксированный размер, чтобы команды не выделяли память
+	 */
+	class UniformList {
+	public:
+		static constexpr size_t CAPACITY = 4;
+
+	private:
+		enum class Type: uint8_t {
+			FLOAT, INT, VEC2, VEC3
+		};
+
+		struct Value {
+			UniformId id;
+			Type type;
+			GLint intValue;
+			glm::vec3 floatValue;
+		};
+
+		Value values[CAPACITY];
+		size_t count = 0;
+
+		Value& add(UniformId id, Type type) noexcept;
+
+	public:
+		void set(Uniform<float>, float) noexcept;
+		void set(Uniform<GLint>, GLint) noexcept;
+		void set(Uniform<glm::vec2>, const glm::vec2&) noexcept;
+		void set(Uniform<glm::vec3>, const glm::vec3&) noexcept;
+
+		bool empty() const noexcept {
+			return count == 0;
+		}
+
+		/// @brief Устанавливает все значения в шейдер. Шейдер должен быть уже использован (Shader::use)
+		void apply(Shader&) const;
+	};
+
+
+	/**
+	 * @brief Команда отрисовки одной модели. Хранит всё, что нужно для отрисовки, и не ссылается на сущность,
+	 * поэтому может быть выполнена в потоке OpenGL, пока поток симуляции уже изменяет сущности
+	 */
+	struct DrawCommand {
+		Shader* shader;
+		const Model* model;
+		glm::mat4 transform;
+		RenderPass pass;
+
+		/// Смещение модели за последний тик. Используется для интерполяции позиции при отрисовке
+		glm::vec3 tickOffset {0.0f};
+
+		/// Цвет, заменяющий цвет модели. Если не задан, используется цвет модели.
+		/// Может быть задан только для ColoredModel
+		std::optional<glm::vec3> color;
+
+		/// Значение uniform-переменной modelBrightness на время отрисовки
+		float brightness = 1.0f;
+
+		/// Если true, то подряд идущие команды с тем же шейдером и VAO рисуются одним вызовом glDrawElementsInstanced.
+		/// Модель должна быть ColoredModel, а шейдер должен принимать матрицу модели и цвет как атрибуты
+		/// экземпляра (InstanceBuffer). Uniform-переменные таких команд не поддерживаются
+		bool instanced = false;
+
+		/// Собственные экземпляры команды в DrawList, если команда добавлена через DrawList::addInstanced.
+		/// Такая команда рисует все экземпляры одним вызовом glDrawElementsInstanced, а transform используется только для сортировки
+		uint32_t instanceStart = 0;
+		uint32_t instanceCount = 0;
+
+		UniformList uniforms;
+
+		DrawCommand(RenderPass pass, Shader& shader, const Model& model, const glm::mat4& transform) noexcept:
+				shader(&shader), model(&model), transform(transform), pass(pass) {}
+
+		/**
+		 * @return Ключ сортировки команды. Старшие биты - проход, затем для непрозрачных моделей:
+		 * шейдер, VAO, текстура, глубина (от ближних к дальним). Прозрачные модели сортируются
+		 * только по глубине от дальних к ближним, чтобы смешивание цветов было правильным
+		 * @param view матрица вида, относительно которой считается глубина
+		 */
+		uint64_t getSortKey(const glm::mat4& view) const noexcept;
+
+		/**
+		 * @brief Отрисовывает модель. Шейдер должен быть уже использован (Shader::use)
+		 * @param tickProgress время, прошедшее с последнего тика, в долях от длины тика (от 0 до 1)
+		 */
+		void execute(float tickProgress) const;
+	};
+
+
+	/**
+	 * @brief Очередь отрисовки. Команды записываются в любом порядке, затем сортируются по ключу (DrawCommand::getSortKey)
+	 * поразрядной сортировкой и выполняются подряд. Благодаря сортировке шейдер переключается только при смене шейдера,
+	 * а команды с одной моделью идут друг за другом. Сохраняет выделенную память между тиками
+	 */
+	class DrawList {
+		struct Entry {
+			uint64_t key;
+			uint32_t index; // Индекс команды в commands
+		};
+
+		std::vector<DrawCommand> commands;
+		std::vector<InstanceData> instances;
+		std::vector<Entry> entries;
+		std::vector<Entry> sortBuffer;
+		size_t transparentStart = 0; // Индекс первой прозрачной команды в entries
+		RenderPass currentPass = RenderPass::OPAQUE;
+
+	public:
+		/// @brief Задаёт проход для следующих команд
+		void setPass(RenderPass pass) noexcept {
+			currentPass = pass;
+		}
+
+		/// @brief Добавляет команду отрисовки в конец списка
+		/// @return Ссылку на добавленную команду, через которую можно задать остальные параметры.
+		/// Ссылка действительна до следующего вызова add
+		DrawCommand& add(Shader& shader, const Model& model, const glm::mat4& transform) {
+			return commands.emplace_back(currentPass, shader, model, transform);
+		}
+
+		/**
+		 * @brief Добавляет команду, которая рисует несколько экземпляров модели одним вызовом glDrawElementsInstanced.
+		 * Экземпляры добавляются через addInstance сразу после этого вызова. Модель должна быть VAOModel
+		 * @param transform матрица, по которой определяется глубина команды при сортировке
+		 * @return Ссылку на добавленную команду. Ссылка действительна до следующего вызова add или addInstanced
+		 */
+		DrawCommand& addInstanced(Shader& shader, const Model& model, const glm::mat4& transform) {
+			DrawCommand& command = add(shader, model, transform);
+			command.instanceStart = instances.size();
+			return command;
+		}
+
+		/// @brief Добавляет экземпляр к последней команде, добавленной через addInstanced
+		void addInstance(const glm::mat4& transform, const glm::vec4& data) {
+			assert(!commands.empty() && commands.back().instanceStart + commands.back().instanceCount == instances.size());
+
+			instances.push_back(InstanceData { transform, data });
+			commands.back().instanceCount += 1;
+		}
+
+		void clear() noexcept {
+			commands.clear();
+			instances.clear();
+			entries.clear();
+			transparentStart = 0;
+			currentPass = RenderPass::OPAQUE;
+		}
+
+		size_t size() const noexcept {
+			return commands.size();
+		}
+
+		/// @brief Сортирует команды по ключу. Должен быть вызван после записи всех команд и до execute
+		/// @param view матрица вида, относительно которой считается глубина
+		void sort(const glm::mat4& view);
+
+		/**
+		 * @brief Выполняет все команды прохода в отсортированном порядке. Переключает шейдер только тогда, когда он меняется.
+		 * Подряд идущие инстансные команды (DrawCommand::instanced) объединяются в одну отрисовку
+		 * @param tickProgress время, прошедшее с последнего тика, в долях от длины тика (от 0 до 1)
+		 */
+		void execute(RenderPass, float tickProgress) const;
+	};
+}
+
+#endif
@@ -0,0 +1,155 @@
+#include "gl_state.h"
+
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <algorithm>
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+namespace hack_game {
+	namespace gl_state {
+
+		static constexpr GLuint UNKNOWN = ~GLuint(0); // Значение, которое не совпадает ни с одним настоящим
+		static constexpr GLuint TEXTURE_UNITS = 8;
+
+		enum Capability {
+			DEPTH_TEST, CULL_FACE, BLEND, MULTISAMPLE, CAPABILITY_COUNT
+		};
+
+		/// Запомненное состояние. Изначально неизвестно, поэтому первые вызовы всегда передаются в OpenGL
+		struct State {
+			GLuint program = UNKNOWN;
+			GLuint vertexArray = UNKNOWN;
+			GLuint activeTextureUnit = UNKNOWN;
+			GLuint textures[TEXTURE_UNITS];      // GL_TEXTURE_2D
+			GLuint textureArrays[TEXTURE_UNITS]; // GL_TEXTURE_2D_ARRAY
+			int8_t capabilities[CAPABILITY_COUNT]; // -1 - неизвестно
+			int8_t depthMask = -1;
+			GLenum blendSourceFactor = UNKNOWN;
+			GLenum blendDestFactor = UNKNOWN;
+
+			State() noexcept {
+				std::fill(std::begin(textures), std::end(textures), UNKNOWN);
+				std::fill(std::begin(textureArrays), std::end(textureArrays), UNKNOWN);
+				std::fill(std::begin(capabilities), std::end(capabilities), -1);
+			}
+		};
+
+		static State state;
+		static FrameStats frameStats;
+
+
+		/// @return true, если значение изменилось, и вызов нужно передать в OpenGL. Обновляет значение и статистику
+		template<typename T>
+		static bool update(T& current, T value) noexcept {
+			if (current == value) {
+				frameStats.suppressed += 1;
+				return false;
+			}
+
+			current = value;
+			frameStats.calls += 1;
+			return true;
+		}
+
+
+		void useProgram(GLuint program) noexcept {
+			if (update(state.program, program)) {
+				glUseProgram(program);
+			}
+		}
+
+		void bindVertexArray(GLuint vertexArray) noexcept {
+			if (update(state.vertexArray, vertexArray)) {
+				glBindVertexArray(vertexArray);
+			}
+		}
+
+		/// @param bound запомненная текстура цели target в блоке unit
+		static void bindTexture(GLuint unit, GLenum target, GLuint& bound, GLuint texture) noexcept {
+			assert(unit < TEXTURE_UNITS);
+
+			if (bound == texture) {
+				frameStats.suppressed += 1;
+				return;
+			}
+
+			if (update(state.activeTextureUnit, unit)) {
+				glActiveTexture(GL_TEXTURE0 + unit);
+			}
+
+			update(bound, texture);
+			glBindTexture(target, texture);
+		}
+
+		void bindTexture(GLuint unit, GLuint texture) noexcept {
+			bindTexture(unit, GL_TEXTURE_2D, state.textures[unit], texture);
+		}
+
+		void bindTextureArray(GLuint unit, GLuint texture) noexcept {
+			bindTexture(unit, GL_TEXTURE_2D_ARRAY, state.textureArrays[unit], texture);
+		}
+
+
+		static Capability getCapability(GLenum capability) noexcept {
+			switch (capability) {
+				case GL_DEPTH_TEST:  return DEPTH_TEST;
+				case GL_CULL_FACE:   return CULL_FACE;
+				case GL_BLEND:       return BLEND;
+				case GL_MULTISAMPLE: return MULTISAMPLE;
+				default:
+					assert(false && "Capability is not cached");
+					return CAPABILITY_COUNT;
+			}
+		}
+
+		void setEnabled(GLenum capability, bool enabled) noexcept {
+			if (update(state.capabilities[getCapability(capability)], static_cast<int8_t>(enabled))) {
+				if (enabled) {
+					glEnable(capability);
+				} else {
+					glDisable(capability);
+				}
+			}
+		}
+
+		void setDepthMask(bool enabled) noexcept {
+			if (update(state.depthMask, static_cast<int8_t>(enabled))) {
+				glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+			}
+		}
+
+		void setBlendFunc(GLenum sourceFactor, GLenum destFactor) noexcept {
+			if (state.blendSourceFactor == sourceFactor && state.blendDestFactor == destFactor) {
+				frameStats.suppressed += 1;
+				return;
+			}
+
+			state.blendSourceFactor = sourceFactor;
+			state.blendDestFactor = destFactor;
+			frameStats.calls += 1;
+			glBlendFunc(sourceFactor, destFactor);
+		}
+
+
+		void invalidate() noexcept {
+			state = State();
+		}
+
+
+		void addDrawCall() noexcept {
+			frameStats.drawCalls += 1;
+		}
+
+
+		const FrameStats& getFrameStats() noexcept {
+			return frameStats;
+		}
+
+		void resetFrameStats() noexcept {
+			frameStats = FrameStats();
+		}
+	}
+}
@@ -0,0 +1,54 @@
+#ifndef HACK_GAME__RENDER__GL_STATE_H
+#define HACK_GAME__RENDER__GL_STATE_H
+
+#include "gl_fwd.h"
+#include <cstddef>
+
+namespace hack_game {
+
+	/**
+	 * @brief Кэш состояния OpenGL. Запоминает текущие программу, VAO, текстуры, смешивание, тест глубины
+	 * и отсечение граней и не передаёт в OpenGL вызовы, которые не изменяют состояние.
+	 * Весь код, который меняет это состояние, должен делать это через функции кэша. Бэкенд ImGui
+	 * восстанавливает состояние после отрисовки, поэтому его вызовы кэш не нарушают.
+	 * Используется только в потоке OpenGL.
+	 */
+	namespace gl_state {
+
+		/// Количество вызовов за кадр
+		struct FrameStats {
+			size_t calls = 0;      // Вызовы, переданные в OpenGL
+			size_t suppressed = 0; // Вызовы, которые не изменили бы состояние и были отброшены
+			size_t drawCalls = 0;  // Вызовы glDraw*, кроме отрисовки ImGui
+		};
+
+		void useProgram(GLuint program) noexcept;
+		void bindVertexArray(GLuint vertexArray) noexcept;
+
+		/// @brief Привязывает текстуру GL_TEXTURE_2D к текстурному блоку. Активный блок переключается только при необходимости
+		void bindTexture(GLuint unit, GLuint texture) noexcept;
+
+		/// @brief Привязывает текстуру GL_TEXTURE_2D_ARRAY к текстурному блоку
+		void bindTextureArray(GLuint unit, GLuint texture) noexcept;
+
+		/// @brief Включает или выключает GL_DEPTH_TEST, GL_CULL_FACE, GL_BLEND или GL_MULTISAMPLE
+		void setEnabled(GLenum capability, bool enabled) noexcept;
+
+		void setDepthMask(bool enabled) noexcept;
+		void setBlendFunc(GLenum sourceFactor, GLenum destFactor) noexcept;
+
+		/// @brief Забывает всё запомненное состояние. Нужно вызвать после кода, который меняет состояние в обход кэша
+		void invalidate() noexcept;
+
+		/// @brief Учитывает вызов glDraw* в статистике кадра
+		void addDrawCall() noexcept;
+
+		/// @return Статистику вызовов с последнего resetFrameStats
+		const FrameStats& getFrameStats() noexcept;
+
+		/// @brief Обнуляет статистику вызовов. Вызывается в начале каждого кадра
+		void resetFrameStats() noexcept;
+	}
+}
+
+#endif
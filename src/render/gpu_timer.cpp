@@ -0,0 +1,213 @@
+#include "gpu_timer.h"
+
+#include <cstdint>
+#include <algorithm>
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+namespace hack_game {
+	namespace gpu_timer {
+		using std::vector;
+		using std::ostream;
+
+		static constexpr size_t FRAMES = 4; // Кадров в кольце. Результаты кадра читаются не раньше, чем через FRAMES - 1 кадров
+		static constexpr GLuint NO_PROGRAM = 0;
+
+		/// Замер между двумя запросами. Для прохода program == NO_PROGRAM
+		struct Range {
+			Pass pass;
+			GLuint program;
+			size_t begin, end; // Индексы запросов в Frame::queries
+		};
+
+		struct Frame {
+			vector<GLuint> queries; // Объекты запросов переиспользуются, их количество только растёт
+			size_t usedQueries = 0;
+			vector<Range> ranges;
+			bool pending = false;   // Запросы отправлены, результаты ещё не прочитаны
+		};
+
+		static bool enabled = false;
+		static ostream* shaderLog = nullptr;
+
+		static Frame frames[FRAMES];
+		static size_t currentFrame = 0;
+
+		static size_t openPasses[PASS_COUNT];
+		static size_t openShader = SIZE_MAX; // Индекс замера текущего шейдера в Frame::ranges
+
+		static FrameTimes latest;
+
+
+		void enable(ostream* log) {
+			enabled = true;
+			shaderLog = log;
+		}
+
+		bool isEnabled() noexcept {
+			return enabled;
+		}
+
+
+		/// @brief Отправляет запрос времени и возвращает его индекс
+		static size_t addTimestamp(Frame& frame) {
+			if (frame.usedQueries == frame.queries.size()) {
+				const size_t oldSize = frame.queries.size();
+				frame.queries.resize(std::max<size_t>(16, oldSize * 2));
+				glGenQueries(GLsizei(frame.queries.size() - oldSize), frame.queries.data() + oldSize);
+			}
+
+			glQueryCounter(frame.queries[frame.usedQueries], GL_TIMESTAMP);
+			return frame.usedQueries++;
+		}
+
+
+		/// @return true, если результаты кадра готовы и прочитаны
+		static bool resolve(Frame& frame) {
+			if (frame.usedQueries == 0) {
+				if (shaderLog != nullptr) {
+					*shaderLog << "frame\n";
+				}
+
+				frame.pending = false;
+				return true;
+			}
+
+			// Запросы времени выполняются по порядку, поэтому достаточно проверить последний
+			GLint available = GL_FALSE;
+			glGetQueryObjectiv(frame.queries[frame.usedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+
+			if (available == GL_FALSE) {
+				return false;
+			}
+
+			static vector<GLuint64> timestamps;
+			timestamps.resize(frame.usedQueries);
+
+			for (size_t i = 0; i < frame.usedQueries; i++) {
+				glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &timestamps[i]);
+			}
+
+			latest.shaders.clear();
+			std::fill(std::begin(latest.passes), std::end(latest.passes), 0);
+
+			for (const Range& range : frame.ranges) {
+				// Незакрытый замер пропускается. Конец замера всегда позже начала, поэтому не бывает нулевым
+				if (range.end == 0) {
+					continue;
+				}
+
+				const GLuint64 time = timestamps[range.end] - timestamps[range.begin];
+
+				if (range.program == NO_PROGRAM) {
+					latest.passes[range.pass] += time;
+					continue;
+				}
+
+				// Шейдер может использоваться в нескольких проходах, его время суммируется
+				const auto it = std::find_if(latest.shaders.begin(), latest.shaders.end(),
+						[&range] (const ShaderTime& shader) { return shader.program == range.program; });
+
+				if (it != latest.shaders.end()) {
+					it->time += time;
+				} else {
+					latest.shaders.push_back(ShaderTime { range.program, time });
+				}
+			}
+
+			if (shaderLog != nullptr) {
+				*shaderLog << "frame\n";
+
+				for (const ShaderTime& shader : latest.shaders) {
+					*shaderLog << shader.program << ' ' << shader.time << '\n';
+				}
+			}
+
+			frame.pending = false;
+			return true;
+		}
+
+
+		void beginFrame() {
+			if (!enabled) {
+				return;
+			}
+
+			// Кадры читаются от старых к новым. Самый старый кадр лежит сразу после текущего
+			for (size_t i = 1; i <= FRAMES; i++) {
+				Frame& frame = frames[(currentFrame + i) % FRAMES];
+
+				if (frame.pending && !resolve(frame)) {
+					break;
+				}
+			}
+
+			currentFrame = (currentFrame + 1) % FRAMES;
+			Frame& frame = frames[currentFrame];
+
+			// Если кадр так и не выполнился за FRAMES кадров, его результаты отбрасываются, чтобы не ждать видеокарту
+			if (frame.pending && shaderLog != nullptr) {
+				*shaderLog << "dropped\n";
+			}
+
+			frame.usedQueries = 0;
+			frame.ranges.clear();
+			frame.pending = true;
+			openShader = SIZE_MAX;
+		}
+
+
+		void beginPass(Pass pass) {
+			if (!enabled) {
+				return;
+			}
+
+			Frame& frame = frames[currentFrame];
+			openPasses[pass] = frame.ranges.size();
+			frame.ranges.push_back(Range { pass, NO_PROGRAM, addTimestamp(frame), 0 });
+		}
+
+		void endPass(Pass pass) {
+			if (!enabled) {
+				return;
+			}
+
+			Frame& frame = frames[currentFrame];
+			frame.ranges[openPasses[pass]].end = addTimestamp(frame);
+		}
+
+
+		void beginShader(GLuint program) {
+			if (!enabled) {
+				return;
+			}
+
+			Frame& frame = frames[currentFrame];
+			const size_t timestamp = addTimestamp(frame);
+
+			// Конец предыдущего шейдера совпадает с началом следующего, поэтому запрос общий
+			if (openShader != SIZE_MAX) {
+				frame.ranges[openShader].end = timestamp;
+			}
+
+			openShader = frame.ranges.size();
+			frame.ranges.push_back(Range { PASS_COUNT, program, timestamp, 0 });
+		}
+
+		void endShader() {
+			if (!enabled || openShader == SIZE_MAX) {
+				return;
+			}
+
+			Frame& frame = frames[currentFrame];
+			frame.ranges[openShader].end = addTimestamp(frame);
+			openShader = SIZE_MAX;
+		}
+
+
+		const FrameTimes& getLatest() noexcept {
+			return latest;
+		}
+	}
+}
@@ -0,0 +1,65 @@
+#ifndef HACK_GAME__RENDER__GPU_TIMER_H
+#define HACK_GAME__RENDER__GPU_TIMER_H
+
+#include "gl_fwd.h"
+#include <vector>
+#include <ostream>
+
+namespace hack_game {
+
+	/**
+	 * @brief Замер времени проходов отрисовки и шейдеров на видеокарте без остановки конвейера.
+	 * Начало и конец каждого замера отмечаются запросами GL_TIMESTAMP. Запросы одного кадра лежат в кольце
+	 * из нескольких кадров, а результаты читаются только тогда, когда видеокарта их уже записала, то есть
+	 * на несколько кадров позже. Если кадр всё ещё не готов, когда его место в кольце понадобилось снова,
+	 * его результаты отбрасываются, а в журнал шейдеров записывается пропущенный кадр. Пока замеры выключены, все функции ничего не делают.
+	 * Используется только в потоке OpenGL.
+	 */
+	namespace gpu_timer {
+
+		/// Замеряемые проходы отрисовки кадра
+		enum Pass {
+			OPAQUE_PASS, TRANSPARENT_PASS, IMGUI_PASS, POSTPROCESSING_PASS, PASS_COUNT
+		};
+
+		/// Время одного шейдера за кадр
+		struct ShaderTime {
+			GLuint program;
+			GLuint64 time; // В наносекундах
+		};
+
+		/// Результаты замеров одного кадра
+		struct FrameTimes {
+			GLuint64 passes[PASS_COUNT] {}; // Время каждого прохода в наносекундах, 0 если проход не отрисовывался
+			std::vector<ShaderTime> shaders; // В порядке первого использования шейдера за кадр
+		};
+
+		/**
+		 * @brief Включает замеры
+		 * @param shaderLog если не nullptr, в него записывается время шейдеров каждого кадра
+		 * в виде строк "<id программы> <наносекунды>". Перед кадром пишется строка "frame", а вместо отброшенного
+		 * кадра - строка "dropped". Строки из одного слова пропускаются старыми скриптами, а show-shaders-time.py
+		 * по ним сопоставляет кадры разных запусков
+		 */
+		void enable(std::ostream* shaderLog);
+
+		bool isEnabled() noexcept;
+
+		/// @brief Начинает новый кадр и читает результаты всех уже готовых кадров
+		void beginFrame();
+
+		void beginPass(Pass);
+		void endPass(Pass);
+
+		/// @brief Начинает замер шейдера program. Предыдущий замер шейдера, если он есть, заканчивается
+		void beginShader(GLuint program);
+
+		/// @brief Заканчивает замер текущего шейдера, если он есть
+		void endShader();
+
+		/// @return Результаты последнего готового кадра
+		const FrameTimes& getLatest() noexcept;
+	}
+}
+
+#endif
@@ -0,0 +1,49 @@
+#include "instance_buffer.h"
+
+#include <cassert>
+#include <cstddef>
+#include <algorithm>
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+namespace hack_game {
+	using std::vector;
+
+	void InstanceBuffer::upload(const vector<InstanceData>& instances) {
+		if (buffer == 0) {
+			glGenBuffers(1, &buffer);
+		}
+
+		glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+		// Буфер только растёт, чтобы не пересоздавать хранилище при небольших колебаниях количества экземпляров
+		if (instances.size() > capacity) {
+			capacity = std::max(instances.size(), capacity * 2);
+		}
+
+		const GLsizeiptr size = GLsizeiptr(instances.size() * sizeof(InstanceData));
+
+		glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(capacity * sizeof(InstanceData)), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, size, instances.data());
+	}
+
+
+	void InstanceBuffer::bindAttributes() const {
+		assert(buffer != 0);
+
+		glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+		// mat4 занимает четыре атрибута подряд, по одному на столбец
+		for (GLuint i = 0; i < 4; i++) {
+			const size_t offset = offsetof(InstanceData, transform) + i * sizeof(glm::vec4);
+			glVertexAttribPointer(TRANSFORM_ATTRIBUTE + i, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), reinterpret_cast<GLvoid*>(offset));
+			glEnableVertexAttribArray(TRANSFORM_ATTRIBUTE + i);
+			glVertexAttribDivisor(TRANSFORM_ATTRIBUTE + i, 1);
+		}
+
+		glVertexAttribPointer(DATA_ATTRIBUTE, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), reinterpret_cast<GLvoid*>(offsetof(InstanceData, data)));
+		glEnableVertexAttribArray(DATA_ATTRIBUTE);
+		glVertexAttribDivisor(DATA_ATTRIBUTE, 1);
+	}
+}
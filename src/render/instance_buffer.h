@@ -0,0 +1,51 @@
+#ifndef HACK_GAME__RENDER__INSTANCE_BUFFER_H
+#define HACK_GAME__RENDER__INSTANCE_BUFFER_H
+
+#include "gl_fwd.h"
+#include <vector>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+namespace hack_game {
+
+	/// Атрибуты одного экземпляра модели при инстансной отрисовке
+	struct InstanceData {
+		glm::mat4 transform;
+
+		/// Данные экземпляра, смысл которых зависит от шейдера.
+		/// Для lightInstanced - цвет (rgb), для particleCube - прозрачность (x) и режим (y)
+		glm::vec4 data;
+	};
+
+
+	/**
+	 * @brief Буфер атрибутов экземпляров для glDrawElementsInstanced. Данные загружаются заново перед каждой
+	 * отрисовкой, старое хранилище буфера отбрасывается, чтобы не ждать завершения предыдущих отрисовок.
+	 * Шейдер должен принимать матрицу модели в атрибуте 2 (занимает 2-5) и данные экземпляра в атрибуте 6.
+	 * Буфер не удаляется, так как живёт до завершения программы, как и VAO моделей.
+	 */
+	class InstanceBuffer {
+		GLuint buffer = 0;
+		size_t capacity = 0; // Ёмкость буфера в экземплярах
+
+	public:
+		static constexpr GLuint TRANSFORM_ATTRIBUTE = 2;
+		static constexpr GLuint DATA_ATTRIBUTE = 6;
+
+		InstanceBuffer() noexcept = default;
+		InstanceBuffer(const InstanceBuffer&) = delete;
+		InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+		GLuint getId() const noexcept {
+			return buffer;
+		}
+
+		/// @brief Загружает атрибуты экземпляров в буфер. Создаёт буфер при первом вызове
+		void upload(const std::vector<InstanceData>&);
+
+		/// @brief Подключает атрибуты экземпляров к текущему привязанному VAO
+		void bindAttributes() const;
+	};
+}
+
+#endif
@@ -0,0 +1,10 @@
+#include "render_snapshot.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace hack_game {
+
+	glm::mat4 RenderSnapshot::getInterpolatedView(float tickProgress) const {
+		// Камера сдвигается назад вместе с моделями, поэтому мир сдвигается в обратную сторону
+		return glm::translate(view, viewTickOffset * (1.0f - tickProgress));
+	}
+}
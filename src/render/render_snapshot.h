@@ -0,0 +1,56 @@
+#ifndef HACK_GAME__RENDER__RENDER_SNAPSHOT_H
+#define HACK_GAME__RENDER__RENDER_SNAPSHOT_H
+
+#include "draw_list.h"
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+namespace hack_game {
+
+	/// Количество сущностей уровня, которые рисуются одним шейдером в одном проходе
+	struct EntityBucket {
+		RenderPass pass;
+		GLuint shader; // id программы шейдера, как в Level::EntityMap
+		size_t entities;
+	};
+
+	/**
+	 * @brief Неизменяемый снимок сцены на момент одного тика. Заполняется потоком симуляции
+	 * и затем только читается потоком OpenGL, поэтому не содержит ссылок на сущности уровня
+	 */
+	struct RenderSnapshot {
+		/// Номер уровня, для которого сделан снимок. 0 - уровень не загружен, снимок пустой
+		uint64_t levelId = 0;
+
+		/// Время тика, после которого сделан снимок
+		std::chrono::steady_clock::time_point tickTime;
+
+		glm::mat4 view {1.0f};
+
+		/// Смещение камеры за последний тик
+		glm::vec3 viewTickOffset {0.0f};
+
+		/// Отсортированная очередь отрисовки обоих проходов
+		DrawList drawList;
+
+		/// Количество выделений памяти в куче, сделанных потоком симуляции за тик и запись этого снимка
+		size_t tickAllocations = 0;
+
+		/// Сущности уровня по шейдерам, в порядке Level::EntityMap. Используется для статистики
+		std::vector<EntityBucket> entityBuckets;
+
+		/// @brief Очищает снимок, сохраняя выделенную память
+		void clear() noexcept {
+			levelId = 0;
+			tickAllocations = 0;
+			drawList.clear();
+			entityBuckets.clear();
+		}
+
+		/// @return Матрицу вида, интерполированную между предыдущим и текущим тиком
+		glm::mat4 getInterpolatedView(float tickProgress) const;
+	};
+}
+
+#endif
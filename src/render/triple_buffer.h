@@ -0,0 +1,59 @@
+#ifndef HACK_GAME__RENDER__TRIPLE_BUFFER_H
+#define HACK_GAME__RENDER__TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace hack_game {
+
+	/**
+	 * @brief Lock-free тройной буфер для передачи данных от одного писателя одному читателю.
+	 * Писатель всегда пишет в свой буфер и затем публикует его, читатель всегда читает последний опубликованный буфер.
+	 * Ни писатель, ни читатель никогда не ждут друг друга. Буферы не копируются, а меняются местами,
+	 * поэтому выделенная в них память переиспользуется.
+	 */
+	template<typename T>
+	class TripleBuffer {
+		static constexpr uint8_t INDEX_MASK = 0b011;
+		static constexpr uint8_t FRESH_BIT  = 0b100;
+
+		T buffers[3];
+
+		uint8_t writeIndex = 0;
+		uint8_t readIndex = 1;
+
+		/// Индекс буфера, который находится между писателем и читателем, и флаг того, что в нём новые данные
+		std::atomic<uint8_t> middle = 2;
+
+	public:
+		/// @return Буфер, в который пишет писатель. Принадлежит писателю до вызова publish
+		T& getWriteBuffer() noexcept {
+			return buffers[writeIndex];
+		}
+
+		/// @brief Публикует буфер писателя и выдаёт ему новый
+		void publish() noexcept {
+			const uint8_t old = middle.exchange(writeIndex | FRESH_BIT, std::memory_order_acq_rel);
+			writeIndex = old & INDEX_MASK;
+		}
+
+		/// @brief Забирает последний опубликованный буфер, если он новый
+		/// @return true, если буфер читателя обновился
+		bool update() noexcept {
+			if ((middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0) {
+				return false;
+			}
+
+			const uint8_t old = middle.exchange(readIndex, std::memory_order_acq_rel);
+			readIndex = old & INDEX_MASK;
+			return true;
+		}
+
+		/// @return Буфер, который читает читатель. Не меняется до следующего вызова update
+		const T& getReadBuffer() const noexcept {
+			return buffers[readIndex];
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef HACK_GAME__SHADER__FRAME_UNIFORMS_H
+#define HACK_GAME__SHADER__FRAME_UNIFORMS_H
+
+#include "gl_fwd.h"
+#include <cstddef>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+namespace hack_game {
+
+	/**
+	 * @brief Общие данные кадра, одинаковые для всех шейдеров. Соответствует блоку Frame в common.glsl
+	 * с раскладкой std140, поэтому vec3 хранятся как vec4.
+	 * Загружается в один uniform-буфер, который подключён ко всем шейдерам
+	 */
+	struct FrameUniforms {
+		static constexpr const char* BLOCK_NAME = "Frame";
+		static constexpr GLuint BINDING = 0;
+
+		glm::mat4 view {1.0f};
+		glm::mat4 projection {1.0f};
+		glm::vec4 lightPos {0.0f};
+		glm::vec4 lightColor {0.0f};
+	};
+
+	static_assert(offsetof(FrameUniforms, projection) == 64);
+	static_assert(offsetof(FrameUniforms, lightPos)   == 128);
+	static_assert(offsetof(FrameUniforms, lightColor) == 144);
+	static_assert(sizeof(FrameUniforms) == 160);
+}
+
+#endif
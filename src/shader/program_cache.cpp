@@ -0,0 +1,162 @@
+#include "program_cache.h"
+#include "mapped_file.h"
+#include "dir_paths.h"
+#include "util.h"
+
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+namespace hack_game {
+	namespace program_cache {
+		using std::string;
+		using std::vector;
+		using std::ofstream;
+
+		namespace fs = std::filesystem;
+
+		static constexpr uint32_t MAGIC = 0x47525048; // "HPRG"
+		static constexpr uint32_t VERSION = 1;
+
+		struct Header {
+			uint32_t magic;
+			uint32_t version;
+			uint64_t key;
+			uint32_t binaryFormat;
+			uint32_t binarySize;
+		};
+
+
+		/// @return true, если драйвер умеет сохранять и загружать бинарный код программ
+		static bool isSupported() {
+			static const bool supported = [] () {
+				if (!GLEW_ARB_get_program_binary) {
+					return false;
+				}
+
+				GLint formatCount = 0;
+				glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+				return formatCount > 0;
+			}();
+
+			return supported;
+		}
+
+		static string getCachePath(const string& name) {
+			return SHADER_CACHE_DIR + name + ".bin";
+		}
+
+		static uint64_t hashString(const char* str, uint64_t hash) {
+			// Завершающий ноль тоже хэшируется, чтобы границы строк влияли на хэш
+			return hashFnv1a(str, std::strlen(str) + 1, hash);
+		}
+
+
+		uint64_t getKey(const string& vertexSource, const string& fragmentSource) {
+			uint64_t hash = FNV1A_OFFSET_BASIS;
+			hash = hashString(vertexSource.c_str(), hash);
+			hash = hashString(fragmentSource.c_str(), hash);
+
+			for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+				const GLubyte* str = glGetString(name);
+				hash = hashString(str != nullptr ? reinterpret_cast<const char*>(str) : "", hash);
+			}
+
+			return hash;
+		}
+
+
+		GLuint load(const string& name, uint64_t key) {
+			if (!isSupported()) {
+				return 0;
+			}
+
+			const MappedFile file(getCachePath(name));
+
+			if (!file.isOpen() || file.getSize() < sizeof(Header)) {
+				return 0;
+			}
+
+			Header header;
+			std::memcpy(&header, file.getData(), sizeof(header));
+
+			if (header.magic != MAGIC || header.version != VERSION || header.key != key ||
+				file.getSize() != sizeof(Header) + header.binarySize) {
+				return 0;
+			}
+
+			const GLuint program = glCreateProgram();
+			glProgramBinary(program, header.binaryFormat, file.getData() + sizeof(Header), GLsizei(header.binarySize));
+
+			// Драйвер может отвергнуть бинарный код, например, после обновления, не изменившего строку версии
+			GLint success;
+			glGetProgramiv(program, GL_LINK_STATUS, &success);
+
+			if (!success) {
+				glDeleteProgram(program);
+				return 0;
+			}
+
+			return program;
+		}
+
+
+		void prepareForSave(GLuint program) {
+			if (isSupported()) {
+				glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+			}
+		}
+
+
+		void save(const string& name, uint64_t key, GLuint program) {
+			if (!isSupported()) {
+				return;
+			}
+
+			GLint length = 0;
+			glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+			if (length <= 0) {
+				return;
+			}
+
+			vector<uint8_t> binary(size_t(length), 0);
+			GLenum binaryFormat;
+			glGetProgramBinary(program, length, &length, &binaryFormat, binary.data());
+
+			const Header header {
+				.magic = MAGIC,
+				.version = VERSION,
+				.key = key,
+				.binaryFormat = binaryFormat,
+				.binarySize = uint32_t(length),
+			};
+
+			const string path = getCachePath(name);
+			const string tempPath = path + ".tmp";
+
+			std::error_code error;
+			fs::create_directories(fs::path(path).parent_path(), error);
+
+			// Файл пишется во временный и затем переименовывается, чтобы не оставить недописанный кэш
+			{
+				ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+
+				file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				file.write(reinterpret_cast<const char*>(binary.data()), length);
+
+				if (!file) {
+					file.close();
+					fs::remove(tempPath, error);
+					return;
+				}
+			}
+
+			fs::rename(tempPath, path, error);
+		}
+	}
+}
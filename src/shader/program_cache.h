@@ -0,0 +1,36 @@
+#ifndef HACK_GAME__SHADER__PROGRAM_CACHE_H
+#define HACK_GAME__SHADER__PROGRAM_CACHE_H
+
+#include "gl_fwd.h"
+#include <string>
+#include <cstdint>
+
+namespace hack_game {
+
+	/**
+	 * @brief Кэш скомпилированных шейдерных программ на диске (glGetProgramBinary / glProgramBinary).
+	 * Ключ кэша - хэш исходников шейдеров после подстановки common.glsl и строк производителя, рендерера
+	 * и версии OpenGL, так что при изменении шейдеров или драйвера программа компилируется заново.
+	 * Если драйвер не поддерживает бинарные программы, кэш ничего не делает
+	 */
+	namespace program_cache {
+
+		/// @return Ключ кэша для программы из шейдеров с исходниками vertexSource и fragmentSource
+		uint64_t getKey(const std::string& vertexSource, const std::string& fragmentSource);
+
+		/**
+		 * @brief Загружает программу из кэша
+		 * @param name имя файла кэша программы
+		 * @return Программу или 0, если её нет в кэше, ключ не совпал или драйвер отверг бинарный код
+		 */
+		GLuint load(const std::string& name, uint64_t key);
+
+		/// @brief Вызывается перед glLinkProgram, чтобы после связывания можно было получить бинарный код программы
+		void prepareForSave(GLuint program);
+
+		/// @brief Сохраняет бинарный код связанной программы. Ошибки записи игнорируются
+		void save(const std::string& name, uint64_t key, GLuint program);
+	}
+}
+
+#endif
@@ -1,48 +1,43 @@
 #include "shader.h"
-#include <string_view>
-#include <iostream>
-#include <stdexcept>
-#include <functional>
+#include "frame_uniforms.h"
+#include "render/gl_state.h"
+#include <vector>
+#include <iterator>
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <GL/glew.h>
 #include <glm/gtc/type_ptr.hpp>
 
 namespace hack_game {
-	using std::cerr;
-	using std::endl;
-	using std::string;
-	using std::string_view;
-	using std::function;
-
 	using glm::vec2;
 	using glm::vec3;
 	using glm::mat4;
 
-	using Uniform = Shader::Uniform;
-	using uniforms_t = Shader::uniforms_t;
-
-	struct Shader::Uniform {
-		Uniform() noexcept {}
 
-		#ifndef NDEBUG
-		GLint id;
-		GLenum type;
-		constexpr Uniform(GLint id, GLenum type) noexcept: id(id), type(type) {}
-		#else
-		GLint id;
-		constexpr Uniform(GLint id, GLenum) noexcept: id(id) {}
-		#endif
+	static constexpr const char* UNIFORM_NAMES[] = {
+		#define HACK_GAME__UNIFORM_NAME(type, name) #name,
+		HACK_GAME__UNIFORMS(HACK_GAME__UNIFORM_NAME)
+		#undef HACK_GAME__UNIFORM_NAME
 	};
 
+	static_assert(std::size(UNIFORM_NAMES) == UNIFORM_COUNT);
+
+	const char* getUniformName(UniformId uniformId) noexcept {
+		return UNIFORM_NAMES[static_cast<size_t>(uniformId)];
+	}
 
-	static uniforms_t createUniforms(GLuint id) {
-		GLint count, maxNameLen;
 
+	#ifndef NDEBUG
+	/// @brief Находит типы всех активных uniform-переменных шейдера и предупреждает о переменных, которых нет в списке
+	static void findUniformTypes(const char* shaderName, GLuint id, GLenum (&types)[UNIFORM_COUNT]) {
+		std::fill(std::begin(types), std::end(types), GL_NONE);
+
+		GLint count, maxNameLen;
 		glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &count);
 		glGetProgramiv(id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLen);
 
-		uniforms_t uniforms;
-		uniforms.reserve(count);
+		std::vector<GLchar> name(maxNameLen);
 
 		// Некоторые реализации OpenGL не принимают nullptr в качестве параметров.
 		// Поэтому на всякий случай лучше создать переменные для этого.
@@ -50,34 +45,71 @@ namespace hack_game {
 		GLint unused2;
 
 		for (GLint i = 0; i < count; i++) {
-			GLchar name[maxNameLen];
+			const GLuint index = static_cast<GLuint>(i);
+			GLint blockIndex;
+			glGetActiveUniformsiv(id, 1, &index, GL_UNIFORM_BLOCK_INDEX, &blockIndex);
+
+			// Переменные из uniform-блоков устанавливаются через буфер
+			if (blockIndex != -1) continue;
+
 			GLenum type;
-			
-			glGetActiveUniform(id, static_cast<GLuint>(i), maxNameLen, &unused1, &unused2, &type, name);
-			uniforms.emplace_back(string(name), Uniform(i, type));
-		}
+			glGetActiveUniform(id, index, maxNameLen, &unused1, &unused2, &type, name.data());
 
-		assert(uniforms.size() == static_cast<size_t>(count));
-		return uniforms;
+			const auto it = std::find_if(std::begin(UNIFORM_NAMES), std::end(UNIFORM_NAMES),
+					[&] (const char* uniformName) { return strcmp(uniformName, name.data()) == 0; });
+
+			if (it != std::end(UNIFORM_NAMES)) {
+				types[it - std::begin(UNIFORM_NAMES)] = type;
+			} else {
+				fprintf(stderr, "Warning: uniform \"%s\" of shader \"%s\" is not declared in HACK_GAME__UNIFORMS\n", name.data(), shaderName);
+			}
+		}
 	}
+	#endif
 
 
 	Shader::Shader(const char* name) noexcept:
-			name(name), id(0), uniforms() {}
+			name(name), id(0) {
+
+		std::fill(std::begin(locations), std::end(locations), -1);
+
+		#ifndef NDEBUG
+		std::fill(std::begin(types), std::end(types), GL_NONE);
+		#endif
+	}
 
 	Shader::Shader(const char* name, GLuint id):
-			name(name), id(id), uniforms(createUniforms(id)) {
+			name(name), id(id) {
+
+		// Расположение переменной не совпадает с её индексом среди активных переменных, поэтому запрашивается по имени
+		for (size_t i = 0; i < UNIFORM_COUNT; i++) {
+			locations[i] = glGetUniformLocation(id, UNIFORM_NAMES[i]);
+		}
+
+		#ifndef NDEBUG
+		findUniformTypes(name, id, types);
+		#endif
+
+		const GLuint frameBlock = glGetUniformBlockIndex(id, FrameUniforms::BLOCK_NAME);
+
+		if (frameBlock != GL_INVALID_INDEX) {
+			glUniformBlockBinding(id, frameBlock, FrameUniforms::BINDING);
+		}
 		
 		use();
-		setUniform("modelBrightness", 1.0f, false);
-		setUniform("texture0", 0, false);
-		setUniform("texture1", 1, false);
-		setUniform("texture2", 2, false);
-		setUniform("texture3", 3, false);
+		setUniform(uniform::modelBrightness, 1.0f);
+		setUniform(uniform::frames, 0);
 	}
 
 	Shader::Shader(Shader&& shader):
-			name(shader.name), id(shader.id), uniforms(std::move(shader.uniforms)) {}
+			name(shader.name), id(shader.id) {
+
+		std::copy(std::begin(shader.locations), std::end(shader.locations), locations);
+
+		#ifndef NDEBUG
+		std::copy(std::begin(shader.types), std::end(shader.types), types);
+		#endif
+	}
 	
 	Shader::~Shader() {}
 
@@ -86,93 +118,70 @@ namespace hack_game {
 	static GLuint lastUsedId = 0;
 
 	void Shader::use() noexcept {
-		glUseProgram(id);
+		gl_state::useProgram(id);
 		lastUsedId = id;
 	}
 	#else
 	void Shader::use() noexcept {
-		glUseProgram(id);
+		gl_state::useProgram(id);
 	}
 	#endif
 
 
-	template<GLenum... types, class Func>
-	static void setUniform0(const uniforms_t& uniforms, const char* uniformName, Shader& shader, bool warn, Func func, const char* typeNames) {
-		(void)typeNames;
-
+	#ifndef NDEBUG
+	GLint Shader::getLocation(UniformId uniformId, GLenum type) const noexcept {
+		const size_t index = static_cast<size_t>(uniformId);
 
-		#ifndef NDEBUG
-		if (shader.getId() != lastUsedId) {
-			fprintf(stderr, "Warning: shader \"%s\" was not used before setUniform\n", shader.getName());
+		if (id != lastUsedId) {
+			fprintf(stderr, "Warning: shader \"%s\" was not used before setUniform\n", name);
 		}
-		#endif
 
-		
-		string_view name = uniformName;
-
-		auto it = std::find_if(
-				uniforms.begin(), uniforms.end(),
-				[name] (const auto& p) { return p.first == name; }
-		);
-
-		if (it != uniforms.end()) {
-		
-			#ifndef NDEBUG
-			const GLenum uniformType = it->second.type;
+		// Сэмплеры устанавливаются как GLint
+		const bool compatible = types[index] == type || types[index] == GL_NONE ||
+				(type == GL_INT && (types[index] == GL_SAMPLER_1D || types[index] == GL_SAMPLER_2D || types[index] == GL_SAMPLER_3D ||
+				                     types[index] == GL_SAMPLER_2D_ARRAY));
 
-			if (((uniformType != types) && ...)) {
-				fprintf(stderr, "Warning: uniform \"%s\" is incompatible with types %s\n", uniformName, typeNames);
-			}
-			#endif
-
-			func(it->second.id);
-		} else if (warn) {
-			fprintf(stderr, "Warning: uniform \"%s\" is not found for shader \"%s\"\n", uniformName, shader.getName());
+		if (!compatible) {
+			fprintf(stderr, "Warning: uniform \"%s\" of shader \"%s\" has another type\n", UNIFORM_NAMES[index], name);
 		}
-	}
 
-	#ifndef NDEBUG
-	#define TEMPLATED_CALL(...) setUniform0<__VA_ARGS__>
-	#define SET_UNIFORM(TEMPLATE_PARAMS, ...) TEMPLATED_CALL TEMPLATE_PARAMS (__VA_ARGS__, #TEMPLATE_PARAMS)
+		return locations[index];
+	}
 	#else
-	#define SET_UNIFORM(TEMPLATE_PARAMS, ...) setUniform0(__VA_ARGS__, nullptr)
+	GLint Shader::getLocation(UniformId uniformId, GLenum) const noexcept {
+		return locations[static_cast<size_t>(uniformId)];
+	}
 	#endif
 
 
-	void Shader::setUniform(const char* uniformName, const mat4& val, bool warn) {
-		SET_UNIFORM((GL_FLOAT_MAT4), uniforms, uniformName, *this, warn, [&] (GLint uid) { glUniformMatrix4fv(uid, 1, GL_FALSE, glm::value_ptr(val)); });
-	}
+	// glUniform* с расположением -1 ничего не делают, поэтому отсутствие переменной не проверяется
 
-	void Shader::setUniform(const char* uniformName, const vec3& val, bool warn) {
-		SET_UNIFORM((GL_FLOAT_VEC3), uniforms, uniformName, *this, warn, [&] (GLint uid) { glUniform3fv(uid, 1, glm::value_ptr(val)); });
+	void Shader::setUniform(Uniform<mat4> uniform, const mat4& val) {
+		glUniformMatrix4fv(getLocation(uniform.id, GL_FLOAT_MAT4), 1, GL_FALSE, glm::value_ptr(val));
 	}
 
-	void Shader::setUniform(const char* uniformName, const vec2& val, bool warn) {
-		SET_UNIFORM((GL_FLOAT_VEC2), uniforms, uniformName, *this, warn, [&] (GLint uid) { glUniform2fv(uid, 1, glm::value_ptr(val)); });
+	void Shader::setUniform(Uniform<vec3> uniform, const vec3& val) {
+		glUniform3fv(getLocation(uniform.id, GL_FLOAT_VEC3), 1, glm::value_ptr(val));
 	}
 
-	void Shader::setUniform(const char* uniformName, float val, bool warn) {
-		SET_UNIFORM((GL_FLOAT), uniforms, uniformName, *this, warn, [=] (GLint uid) { glUniform1f(uid, val); });
+	void Shader::setUniform(Uniform<vec2> uniform, const vec2& val) {
+		glUniform2fv(getLocation(uniform.id, GL_FLOAT_VEC2), 1, glm::value_ptr(val));
 	}
 
-	void Shader::setUniform(const char* uniformName, GLint val, bool warn) {
-		SET_UNIFORM((GL_INT, GL_SAMPLER_1D, GL_SAMPLER_2D, GL_SAMPLER_3D), uniforms, uniformName, *this, warn, [=] (GLint uid) { glUniform1i(uid, val); });
+	void Shader::setUniform(Uniform<float> uniform, float val) {
+		glUniform1f(getLocation(uniform.id, GL_FLOAT), val);
 	}
 
-	void Shader::setUniform(const char* uniformName, GLuint val, bool warn) {
-		SET_UNIFORM((GL_UNSIGNED_INT), uniforms, uniformName, *this, warn, [=] (GLint uid) { glUniform1ui(uid, val); });
+	void Shader::setUniform(Uniform<GLint> uniform, GLint val) {
+		glUniform1i(getLocation(uniform.id, GL_INT), val);
 	}
 
 
 	void Shader::setModel(const mat4& mat) {
-		setUniform("model", mat);
-	}
-
-	void Shader::setView(const mat4& mat) {
-		setUniform("view", mat);
+		setUniform(uniform::model, mat);
 	}
 
 	void Shader::setModelColor(const vec3& vec) {
-		setUniform("modelColor", vec, false);
+		setUniform(uniform::modelColor, vec);
 	}
 }
@@ -2,22 +2,23 @@
 #define HACK_GAME__CONTEXT__SHADER_H
 
 #include "gl_fwd.h"
-#include <vector>
-#include <string>
+#include "uniforms.h"
+#include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/mat4x4.hpp>
 
 namespace hack_game {
 
 	class Shader {
-	public:
-		struct Uniform;
-		using uniforms_t = std::vector<std::pair<std::string, Uniform>>;
-
-	private:
 		const char* const name;
 		const GLuint id;
-		const uniforms_t uniforms;
+
+		/// Расположения uniform-переменных из списка HACK_GAME__UNIFORMS. -1, если переменной нет в шейдере
+		GLint locations[UNIFORM_COUNT];
+
+		#ifndef NDEBUG
+		GLenum types[UNIFORM_COUNT]; // Типы переменных в шейдере, используются для проверки
+		#endif
 	
 	public:
 		explicit Shader(const char* name) noexcept;
@@ -33,19 +34,26 @@ namespace hack_game {
 			return id;
 		}
 
+		/// @return true, если uniform-переменная есть в шейдере
+		bool hasUniform(UniformId uniformId) const noexcept {
+			return locations[static_cast<size_t>(uniformId)] != -1;
+		}
+
 		void use() noexcept;
 
-		void setUniform(const char* name, const glm::mat4& val, bool warn = true);
-		void setUniform(const char* name, const glm::vec3& val, bool warn = true);
-		void setUniform(const char* name, const glm::vec2& val, bool warn = true);
-		void setUniform(const char* name, float val, bool warn = true);
-		void setUniform(const char* name, GLint val, bool warn = true);
-		void setUniform(const char* name, GLuint val, bool warn = true);
+		// Шейдер должен быть уже использован (use). Если переменной нет в шейдере, ничего не происходит
+		void setUniform(Uniform<glm::mat4>, const glm::mat4& val);
+		void setUniform(Uniform<glm::vec3>, const glm::vec3& val);
+		void setUniform(Uniform<glm::vec2>, const glm::vec2& val);
+		void setUniform(Uniform<float>, float val);
+		void setUniform(Uniform<GLint>, GLint val);
 
 		void setModel(const glm::mat4&);
-		void setView(const glm::mat4&);
 		void setModelColor(const glm::vec3&);
+
+	private:
+		GLint getLocation(UniformId, GLenum type) const noexcept;
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
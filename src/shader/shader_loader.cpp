@@ -1,4 +1,5 @@
 #include "shader_loader.h"
+#include "program_cache.h"
 #include "dir_paths.h"
 
 #include <iostream>
@@ -6,6 +7,7 @@
 #include <sstream>
 #include <string>
 #include <memory>
+#include <algorithm>
 
 namespace hack_game {
 	using std::cout;
@@ -43,7 +45,8 @@ namespace hack_game {
 		return content;
 	}
 
-	static GLuint compileShader(GLenum type, const char* path) {
+	/// @return Исходник шейдера с подставленным common.glsl
+	static string readSource(const char* path) {
 		string source = readFile(path);
 		size_t includePos = source.find(COMMON_INCLUDE);
 
@@ -51,12 +54,14 @@ namespace hack_game {
 			source.replace(includePos, std::size(COMMON_INCLUDE) - 1, getCommonContent());
 		}
 
+		return source;
+	}
+
+	static GLuint compileShader(GLenum type, const char* path, const string& source) {
 		GLuint shader = glCreateShader(type);
 
 		const char* str = source.c_str();
 		glShaderSource(shader, 1, &str, nullptr);
-
-		source.clear();
 		
 		
 		glCompileShader(shader);
@@ -88,10 +93,29 @@ namespace hack_game {
 	}
 
 
+	/// @return Имя файла кэша программы: пути к шейдерам относительно папки шейдеров
+	static string getCacheName(const char* vertexShaderPath, const char* fragmentShaderPath) {
+		string name = string(vertexShaderPath + std::size(SHADERS_DIR) - 1) + '+' + (fragmentShaderPath + std::size(SHADERS_DIR) - 1);
+		std::replace(name.begin(), name.end(), '/', '_');
+		return name;
+	}
+
+
 	static GLuint createShaderProgram0(const char* vertexShaderPath, const char* fragmentShaderPath) {
-		// Читаем и компилируем шейдеры
-		GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderPath);
-		GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderPath);
+		const string vertexSource = readSource(vertexShaderPath);
+		const string fragmentSource = readSource(fragmentShaderPath);
+
+		// Сначала ищем уже скомпилированную программу в кэше
+		const string cacheName = getCacheName(vertexShaderPath, fragmentShaderPath);
+		const uint64_t cacheKey = program_cache::getKey(vertexSource, fragmentSource);
+
+		if (GLuint cachedProgram = program_cache::load(cacheName, cacheKey)) {
+			return cachedProgram;
+		}
+
+		// Компилируем шейдеры
+		GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderPath, vertexSource);
+		GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderPath, fragmentSource);
 
 		if (vertexShader == 0 || fragmentShader == 0) {
 			exit(EXIT_FAILURE);
@@ -103,6 +127,7 @@ namespace hack_game {
 		glAttachShader(shaderProgram, vertexShader);
 		glAttachShader(shaderProgram, fragmentShader);
 
+		program_cache::prepareForSave(shaderProgram);
 		glLinkProgram(shaderProgram);
 		
 		GLint success;
@@ -117,6 +142,7 @@ namespace hack_game {
 		glDeleteShader(vertexShader);
 		glDeleteShader(fragmentShader);
 
+		program_cache::save(cacheName, cacheKey, shaderProgram);
 		return shaderProgram;
 	}
 
@@ -1,6 +1,10 @@
 #include "shader_manager.h"
 #include "util.h"
 #include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+#define GLEW_STATIC
+#include <GL/glew.h>
 
 namespace hack_game {
 
@@ -26,31 +30,45 @@ namespace hack_game {
 	}
 
 	void ShaderManager::initShaders(int windowWidth, int windowHeight) {
-		const mat4 projection = glm::perspective(45.0f, float(windowWidth) / float(windowHeight), 0.1f, 100.0f);
+		shadersById.emplace(nullShader.getId(), &nullShader);
+
+		// В режиме --headless все шейдеры пустые, и устанавливать uniform-переменные некуда
+		if (isHeadless()) {
+			return;
+		}
 
-		mainShader.use();
-		mainShader.setUniform("projection", projection);
-		mainShader.setUniform("lightColor", lightColor);
-		mainShader.setUniform("lightPos",   lightPos);
+		frameUniforms.projection = glm::perspective(45.0f, float(windowWidth) / float(windowHeight), 0.1f, 100.0f);
+		frameUniforms.lightColor = glm::vec4(lightColor, 0.0f);
+		frameUniforms.lightPos   = glm::vec4(lightPos, 1.0f);
+
+		glGenBuffers(1, &frameUniformBuffer);
+		glBindBuffer(GL_UNIFORM_BUFFER, frameUniformBuffer);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), &frameUniforms, GL_DYNAMIC_DRAW);
+		glBindBufferBase(GL_UNIFORM_BUFFER, FrameUniforms::BINDING, frameUniformBuffer);
 
 		Shader& postprocessing = shaders.at("postprocessing");
 		postprocessing.use();
-		postprocessing.setUniform("sceneTexture", 0);
-		postprocessing.setUniform("guiTexture", 1);
-		postprocessing.setUniform("seed", randomInt32());
-
-		for (auto& entry : shaders) {
-			entry.second.use();
-			entry.second.setUniform("projection", projection);
-		}
+		postprocessing.setUniform(uniform::sceneTexture, 0);
+		postprocessing.setUniform(uniform::guiTexture, 1);
+		postprocessing.setUniform(uniform::seed, static_cast<GLint>(std::random_device()()));
 
-		shadersById.emplace(nullShader.getId(), &nullShader);
 		shadersById.emplace(mainShader.getId(), &mainShader);
 	}
 
+	void ShaderManager::setView(const mat4& view) {
+		frameUniforms.view = view;
+
+		glBindBuffer(GL_UNIFORM_BUFFER, frameUniformBuffer);
+		glBufferSubData(GL_UNIFORM_BUFFER, offsetof(FrameUniforms, view), sizeof(view), &frameUniforms.view);
+	}
+
 	void ShaderManager::updateWindowSize(GLint width, GLint height) {
+		if (isHeadless()) {
+			return;
+		}
+
 		Shader& postprocessing = shaders.at("postprocessing");
 		postprocessing.use();
-		postprocessing.setUniform("pixelSize", vec2(1.0f / width, 1.0f / height));
+		postprocessing.setUniform(uniform::pixelSize, vec2(1.0f / width, 1.0f / height));
 	}
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define HACK_GAME__SHADER__SHADER_MANAGER_H
 
 #include "shader.h"
+#include "frame_uniforms.h"
 #include <map>
 #include <string>
 
@@ -15,6 +16,9 @@ namespace hack_game {
 		std::map<std::string_view, Shader> shaders;
 		std::map<GLuint, Shader*> shadersById;
 
+		FrameUniforms frameUniforms;
+		GLuint frameUniformBuffer = 0;
+
 	public:
 		template<typename... Shaders>
 		ShaderManager(int windowWidth, int windowHeight, Shader&& nullShader, Shader&& mainShader, Shaders&&... shaders):
@@ -33,9 +37,18 @@ namespace hack_game {
 			return shadersById;
 		}
 
+		/// @return true, если шейдеры не были скомпилированы (режим --headless). В таком режиме отрисовка невозможна
+		bool isHeadless() const noexcept {
+			return mainShader.getId() == 0;
+		}
+
 		Shader& getShader(const char* name);
 		Shader& getShader(GLuint id);
 
+		/// @brief Устанавливает матрицу вида в общий uniform-буфер кадра (FrameUniforms), который видят все шейдеры.
+		/// Вызывается один раз за кадр перед отрисовкой сцены
+		void setView(const glm::mat4& view);
+
 		void updateWindowSize(GLint width, GLint height);
 	
 	private:
@@ -0,0 +1,63 @@
+#ifndef HACK_GAME__SHADER__UNIFORMS_H
+#define HACK_GAME__SHADER__UNIFORMS_H
+
+#include "gl_fwd.h"
+#include <cstddef>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+
+/**
+ * Список всех uniform-переменных, которые устанавливаются из кода: X(тип в C++, имя в шейдере).
+ * Расположения всех переменных из списка находятся один раз при создании шейдера,
+ * поэтому при установке значения не нужно искать переменную по имени.
+ * Общие для кадра переменные (матрицы вида и проекции, свет) хранятся в uniform-буфере (FrameUniforms).
+ */
+#define HACK_GAME__UNIFORMS(X) \
+	X(glm::mat4, model)           \
+	X(glm::vec3, modelColor)      \
+	X(float,     modelBrightness) \
+	X(float,     progress)        \
+	X(glm::vec3, centerPos)       \
+	X(glm::vec3, angleNormal)     \
+	X(GLint,     seed)            \
+	X(GLint,     frames)          \
+	X(GLint,     firstFrame)      \
+	X(GLint,     sceneTexture)    \
+	X(GLint,     guiTexture)      \
+	X(glm::vec2, pixelSize)       \
+	X(float,     winScreenTime)   \
+	X(float,     guiFadeProgress)
+
+namespace hack_game {
+
+	/// Номер uniform-переменной в списке HACK_GAME__UNIFORMS
+	enum class UniformId: uint8_t {
+		#define HACK_GAME__UNIFORM_ID(type, name) name,
+		HACK_GAME__UNIFORMS(HACK_GAME__UNIFORM_ID)
+		#undef HACK_GAME__UNIFORM_ID
+	};
+
+	#define HACK_GAME__UNIFORM_COUNT(type, name) + 1
+	inline constexpr size_t UNIFORM_COUNT = 0 HACK_GAME__UNIFORMS(HACK_GAME__UNIFORM_COUNT);
+	#undef HACK_GAME__UNIFORM_COUNT
+
+	/// @return Имя uniform-переменной в шейдере
+	const char* getUniformName(UniformId) noexcept;
+
+
+	/// Типизированный дескриптор uniform-переменной. Тип значения проверяется при компиляции
+	template<typename T>
+	struct Uniform {
+		UniformId id;
+	};
+
+	/// Дескрипторы всех uniform-переменных, например uniform::model
+	namespace uniform {
+		#define HACK_GAME__UNIFORM_HANDLE(type, name) inline constexpr Uniform<type> name { UniformId::name };
+		HACK_GAME__UNIFORMS(HACK_GAME__UNIFORM_HANDLE)
+		#undef HACK_GAME__UNIFORM_HANDLE
+	}
+}
+
+#endif
@@ -1,28 +1,35 @@
 #include "texture.h"
+#include "render/gl_state.h"
 #include <string>
-#include <fstream>
-#include <SOIL/SOIL.h>
+#include <ios>
 #define GLEW_STATIC
 #include <GL/glew.h>
 
 namespace hack_game {
+	using texture_file::TextureData;
+	using texture_file::getLevelSize;
 
 	static const float BORDER_COLOR[] = {0, 0, 0, 0};
 
-	Texture::Texture(const char* path) {
-		data = SOIL_load_image(path, &width, &height, nullptr, SOIL_LOAD_RGBA);
-
-		if (data == nullptr) {
+	static TextureData loadData(const MappedFile& file, const char* path) {
+		if (!file.isOpen()) {
 			throw std::ios_base::failure(std::string("Cannot open file '") + path + "'");
 		}
-	}
 
-	Texture::~Texture() {
-		if (data != nullptr) {
-			SOIL_free_image_data(data);
+		const std::optional<TextureData> data = texture_file::load(file);
+
+		if (!data.has_value()) {
+			throw std::ios_base::failure(std::string("File '") + path + "' is not a valid texture, rebuild the 'textures' target");
 		}
+
+		return *data;
 	}
 
+	Texture::Texture(const char* path):
+			file(path), data(loadData(file, path)) {}
+
+	Texture::~Texture() {}
+
 
 	GLuint Texture::genGlTexture() const {
 		return genGlTexture(GL_LINEAR);
@@ -40,13 +47,41 @@ namespace hack_game {
 	}
 
 	void Texture::bindGlTexture(GLuint textureId, GLint filter) const {
-		glBindTexture(GL_TEXTURE_2D, textureId);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+		gl_state::bindTexture(0, textureId);
+
+		const GLenum internalFormat = texture_file::getInternalFormat(data.format);
+		const uint8_t* levelData = data.levels;
+
+		// Строки формата RGB8 не выровнены по 4 байта
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		for (GLint level = 0; level < data.levelCount; level++) {
+			const GLsizei width = getLevelSize(data.width, level);
+			const GLsizei height = getLevelSize(data.height, level);
+			const size_t size = texture_file::getDataSize(data.format, width, height);
+
+			if (texture_file::isCompressed(data.format)) {
+				glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, GLsizei(size), levelData);
+			} else {
+				glTexImage2D(GL_TEXTURE_2D, level, GLint(internalFormat), width, height, 0,
+						texture_file::getPixelFormat(data.format), GL_UNSIGNED_BYTE, levelData);
+			}
+
+			levelData += size;
+		}
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+		GLint swizzle[4];
+		texture_file::getSwizzle(data.format, swizzle);
+
+		glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, data.levelCount - 1);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter == GL_NEAREST ? GL_NEAREST_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
 		glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, BORDER_COLOR);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		gl_state::bindTexture(0, 0);
 	}
-}
\ No newline at end of file
+}
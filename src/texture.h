@@ -2,35 +2,46 @@
 #define HACK_GAME__TEXTURE_H
 
 #include "gl_fwd.h"
+#include "mapped_file.h"
+#include "texture_file.h"
 
 namespace hack_game {
 
-	/// @brief Данный класс отвечает за загрузку текстуры и генерацию объекта текстуры в OpenGL
+	/**
+	 * @brief Данный класс отвечает за загрузку текстуры и генерацию объекта текстуры в OpenGL.
+	 * Текстура читается из файла .tex (см. texture_file), который уже содержит все уровни mipmap,
+	 * поэтому при загрузке файл только отображается в память, а не декодируется
+	 */
 	class Texture {
-		int width, height;
-		uint8_t* data;
+		const MappedFile file;
+		texture_file::TextureData data;
 
 	public:
 		/// @brief Загружает текстуру из файла
-		/// @param path путь к файлу относительно текущей папки или абсолютный путь
+		/// @param path путь к файлу .tex относительно текущей папки или абсолютный путь
+		/// @throw std::ios_base::failure если файл не удалось открыть или он повреждён
 		explicit Texture(const char* path);
 
 		/// @brief Очищает все данные текстуры в памяти (но не в OpenGL!)
 		~Texture();
 
+		const texture_file::TextureData& getData() const noexcept {
+			return data;
+		}
+
 		/// @brief Работает также, как genGlTexture(GLint). filter по умолчанию GL_LINEAR
 		/// @return ID созданного объекта текстуры
 		GLuint genGlTexture() const;
 
 		/// @brief Создаёт новый объект текстуры в OpenGL
-		/// @param filter Режим фильтрации текстур OpenGL
+		/// @param filter Режим фильтрации текстур OpenGL. При уменьшении между уровнями mipmap фильтрация всегда линейная
 		/// @return ID созданного объекта текстуры
 		GLuint genGlTexture(GLint filter) const;
-		
+
 		/// @brief Работает также, как bindGlTexture(GLuint, GLint). filter по умолчанию GL_LINEAR
 		/// @param textureId ID объекта текстуры в OpenGL
 		void bindGlTexture(GLuint textureId) const;
-		
+
 		/// @brief Привязывает данные текстуры к объекту OpenGL
 		/// @param textureId ID объекта текстуры в OpenGL
 		/// @param filter Режим фильтрации текстур OpenGL
@@ -38,4 +49,4 @@ namespace hack_game {
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,168 @@
+#include "texture_file.h"
+#include "mapped_file.h"
+
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+namespace hack_game {
+	namespace texture_file {
+		using std::string;
+		using std::ofstream;
+		using std::optional;
+		using std::nullopt;
+
+		namespace fs = std::filesystem;
+
+		static constexpr uint32_t MAGIC = 0x58455448; // "HTEX"
+		static constexpr uint32_t VERSION = 1;
+
+		static constexpr GLint MAX_LEVELS = 16;
+
+		struct Header {
+			uint32_t magic;
+			uint32_t version;
+			Format format;
+			uint32_t width;
+			uint32_t height;
+			uint32_t levelCount;
+		};
+
+		static_assert(sizeof(Header) % 4 == 0);
+
+
+		size_t getDataSize(Format format, GLsizei width, GLsizei height) noexcept {
+			// Сжатые форматы хранят блоки 4x4 пикселя, неполные блоки на краях занимают место целиком
+			const size_t blocks = size_t((width + 3) / 4) * size_t((height + 3) / 4);
+			const size_t pixels = size_t(width) * size_t(height);
+
+			switch (format) {
+				case Format::RGBA8: return pixels * 4;
+				case Format::RGB8:  return pixels * 3;
+				case Format::RGTC1: return blocks * 8;
+				case Format::RGTC2: return blocks * 16;
+			}
+
+			return 0;
+		}
+
+		GLenum getInternalFormat(Format format) noexcept {
+			switch (format) {
+				case Format::RGBA8: return GL_RGBA8;
+				case Format::RGB8:  return GL_RGB8;
+				case Format::RGTC1: return GL_COMPRESSED_RED_RGTC1;
+				case Format::RGTC2: return GL_COMPRESSED_RG_RGTC2;
+			}
+
+			return GL_NONE;
+		}
+
+		GLenum getPixelFormat(Format format) noexcept {
+			return format == Format::RGB8 ? GL_RGB : GL_RGBA;
+		}
+
+		bool isCompressed(Format format) noexcept {
+			return format == Format::RGTC1 || format == Format::RGTC2;
+		}
+
+		void getSwizzle(Format format, GLint swizzle[4]) noexcept {
+			switch (format) {
+				case Format::RGTC1:
+					swizzle[0] = swizzle[1] = swizzle[2] = GL_RED;
+					swizzle[3] = GL_ONE;
+					break;
+
+				case Format::RGTC2:
+					swizzle[0] = swizzle[1] = swizzle[2] = GL_RED;
+					swizzle[3] = GL_GREEN;
+					break;
+
+				default:
+					swizzle[0] = GL_RED;
+					swizzle[1] = GL_GREEN;
+					swizzle[2] = GL_BLUE;
+					swizzle[3] = GL_ALPHA;
+					break;
+			}
+		}
+
+
+		/// @return Размер всех уровней в байтах
+		static size_t getTotalSize(Format format, GLsizei width, GLsizei height, GLint levelCount) noexcept {
+			size_t size = 0;
+
+			for (GLint level = 0; level < levelCount; level++) {
+				size += getDataSize(format, getLevelSize(width, level), getLevelSize(height, level));
+			}
+
+			return size;
+		}
+
+
+		optional<TextureData> load(const MappedFile& file) {
+			if (!file.isOpen() || file.getSize() < sizeof(Header)) {
+				return nullopt;
+			}
+
+			Header header;
+			std::memcpy(&header, file.getData(), sizeof(header));
+
+			if (header.magic != MAGIC || header.version != VERSION || header.format > Format::RGTC2 ||
+				header.width == 0 || header.height == 0 || header.levelCount == 0 || header.levelCount > MAX_LEVELS) {
+				return nullopt;
+			}
+
+			const TextureData data {
+				.format = header.format,
+				.width = GLsizei(header.width),
+				.height = GLsizei(header.height),
+				.levelCount = GLint(header.levelCount),
+				.levels = file.getData() + sizeof(Header),
+			};
+
+			if (file.getSize() != sizeof(Header) + getTotalSize(data.format, data.width, data.height, data.levelCount)) {
+				return nullopt;
+			}
+
+			return data;
+		}
+
+
+		bool save(const string& path, const TextureData& data) {
+			std::error_code error;
+			fs::create_directories(fs::path(path).parent_path(), error);
+
+			const Header header {
+				.magic = MAGIC,
+				.version = VERSION,
+				.format = data.format,
+				.width = uint32_t(data.width),
+				.height = uint32_t(data.height),
+				.levelCount = uint32_t(data.levelCount),
+			};
+
+			// Файл пишется во временный и затем переименовывается, чтобы не оставить недописанную текстуру
+			const string tempPath = path + ".tmp";
+
+			{
+				ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+
+				file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				file.write(reinterpret_cast<const char*>(data.levels),
+						std::streamsize(getTotalSize(data.format, data.width, data.height, data.levelCount)));
+
+				if (!file) {
+					file.close();
+					fs::remove(tempPath, error);
+					return false;
+				}
+			}
+
+			fs::rename(tempPath, path, error);
+			return !error;
+		}
+	}
+}
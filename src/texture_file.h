@@ -0,0 +1,67 @@
+#ifndef HACK_GAME__TEXTURE_FILE_H
+#define HACK_GAME__TEXTURE_FILE_H
+
+#include "gl_fwd.h"
+#include <string>
+#include <cstdint>
+#include <optional>
+
+namespace hack_game {
+
+	class MappedFile;
+
+	/**
+	 * @brief Формат файлов .tex, в которые texture_converter при сборке переводит изображения из resources/textures/.
+	 * Файл содержит все уровни mipmap в том виде, в котором они передаются в OpenGL, так что при загрузке
+	 * изображение не декодируется. Раскладка файла: | заголовок | уровень 0 | уровень 1 | ... |
+	 */
+	namespace texture_file {
+
+		/// Формат пикселей. Выбирается конвертером по содержимому изображения
+		enum class Format: uint32_t {
+			RGBA8, // Цветное с прозрачностью
+			RGB8,  // Цветное непрозрачное
+			RGTC1, // Серое непрозрачное, один канал со сжатием RGTC (0.5 байта на пиксель)
+			RGTC2, // Серое с прозрачностью, два канала со сжатием RGTC (1 байт на пиксель)
+		};
+
+		/// Данные текстуры в памяти
+		struct TextureData {
+			Format format;
+			GLsizei width, height;
+			GLint levelCount;
+			const uint8_t* levels; // Все уровни подряд, начиная с нулевого
+		};
+
+		/// @return Размер уровня mipmap в пикселях, если размер нулевого уровня равен size
+		inline GLsizei getLevelSize(GLsizei size, GLint level) noexcept {
+			return size >> level > 0 ? size >> level : 1;
+		}
+
+		/// @return Размер данных одного уровня в байтах
+		size_t getDataSize(Format, GLsizei width, GLsizei height) noexcept;
+
+		/// @return Внутренний формат OpenGL
+		GLenum getInternalFormat(Format) noexcept;
+
+		/// @return Формат данных для glTexImage*. Не используется для сжатых форматов
+		GLenum getPixelFormat(Format) noexcept;
+
+		bool isCompressed(Format) noexcept;
+
+		/**
+		 * @brief Заполняет перестановку каналов для GL_TEXTURE_SWIZZLE_RGBA,
+		 * с которой серые форматы читаются в шейдере как RGBA
+		 */
+		void getSwizzle(Format, GLint swizzle[4]) noexcept;
+
+		/// @return Данные текстуры, указывающие в память file, или std::nullopt, если файл не открыт или повреждён
+		std::optional<TextureData> load(const MappedFile& file);
+
+		/// @brief Записывает текстуру в файл
+		/// @return true, если файл записан
+		bool save(const std::string& path, const TextureData& data);
+	}
+}
+
+#endif
@@ -0,0 +1,206 @@
+#include "trace.h"
+#include "dir_paths.h"
+
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <filesystem>
+
+namespace hack_game {
+	namespace trace {
+		using std::string;
+		using std::vector;
+		using std::unique_ptr;
+		using std::atomic;
+		using std::memory_order_relaxed;
+		using std::memory_order_acquire;
+		using std::memory_order_release;
+
+		using clock = std::chrono::steady_clock;
+
+		static constexpr uint64_t CAPACITY = 1 << 15; // Замеров в буфере одного потока
+		static constexpr const char* TRACE_FILE = DEBUG_DIR "trace.json";
+
+		/// Поля атомарные, потому что dump читает их параллельно с записью. Отношения порядка между ними не нужны
+		struct Event {
+			atomic<const char*> name;
+			atomic<int64_t> begin, end; // В наносекундах от startTime
+		};
+
+		/// Буфер пишет только его поток, а читает только dump
+		struct ThreadBuffer {
+			string name;
+			const size_t id;
+			atomic<uint64_t> written = 0; // Всего записано замеров. Замер i лежит в events[i % CAPACITY]
+			Event events[CAPACITY];
+
+			explicit ThreadBuffer(size_t id) noexcept:
+					id(id) {}
+		};
+
+		static atomic<bool> enabled = false;
+		static const clock::time_point startTime = clock::now();
+
+		static std::mutex buffersMutex; // Защищает только список буферов
+		static vector<unique_ptr<ThreadBuffer>> buffers;
+		static thread_local ThreadBuffer* threadBuffer = nullptr;
+
+
+		void enable() noexcept {
+			enabled.store(true, memory_order_relaxed);
+		}
+
+		bool isEnabled() noexcept {
+			return enabled.load(memory_order_relaxed);
+		}
+
+
+		static int64_t now() noexcept {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - startTime).count();
+		}
+
+		/// @brief Создаёт буфер потока при первом замере. Блокировка берётся один раз на поток
+		static ThreadBuffer& getThreadBuffer() {
+			if (threadBuffer == nullptr) {
+				std::lock_guard lock(buffersMutex);
+				buffers.push_back(std::make_unique<ThreadBuffer>(buffers.size() + 1));
+				threadBuffer = buffers.back().get();
+			}
+
+			return *threadBuffer;
+		}
+
+
+		void setThreadName(const char* name) {
+			if (!isEnabled()) {
+				return;
+			}
+
+			ThreadBuffer& buffer = getThreadBuffer();
+			std::lock_guard lock(buffersMutex);
+			buffer.name = name;
+		}
+
+
+		Zone::Zone(const char* name) noexcept:
+				name(isEnabled() ? name : nullptr),
+				begin(this->name != nullptr ? now() : 0) {}
+
+		Zone::~Zone() {
+			if (name == nullptr) {
+				return;
+			}
+
+			ThreadBuffer& buffer = getThreadBuffer();
+			const uint64_t index = buffer.written.load(memory_order_relaxed);
+			Event& event = buffer.events[index % CAPACITY];
+
+			// Парный барьеру в copyEvents: если dump увидит хотя бы одно поле этого замера,
+			// то и повторное чтение written вернёт не меньше index, и старый замер в ячейке будет отброшен
+			std::atomic_thread_fence(memory_order_release);
+
+			event.name.store(name, memory_order_relaxed);
+			event.begin.store(begin, memory_order_relaxed);
+			event.end.store(now(), memory_order_relaxed);
+			buffer.written.store(index + 1, memory_order_release);
+		}
+
+
+		static void writeString(std::ostream& out, const char* str) {
+			out << '"';
+
+			for (; *str != '\0'; str++) {
+				if (*str == '"' || *str == '\\') {
+					out << '\\';
+				}
+
+				out << *str;
+			}
+
+			out << '"';
+		}
+
+		static void writeMicroseconds(std::ostream& out, int64_t nanoseconds) {
+			out << nanoseconds / 1000 << '.' << std::setw(3) << std::setfill('0') << nanoseconds % 1000;
+		}
+
+
+		struct EventCopy {
+			const char* name;
+			int64_t begin, end;
+		};
+
+		/// @brief Копирует замеры буфера, которые не были перезаписаны во время копирования
+		static void copyEvents(const ThreadBuffer& buffer, vector<EventCopy>& result) {
+			result.clear();
+
+			const uint64_t written = buffer.written.load(memory_order_acquire);
+			const uint64_t first = written > CAPACITY ? written - CAPACITY : 0;
+
+			for (uint64_t i = first; i < written; i++) {
+				const Event& event = buffer.events[i % CAPACITY];
+				result.push_back(EventCopy {
+					event.name.load(memory_order_relaxed),
+					event.begin.load(memory_order_relaxed),
+					event.end.load(memory_order_relaxed),
+				});
+			}
+
+			// Поток мог записать ещё несколько замеров поверх самых старых, а его следующий замер
+			// может прямо сейчас писаться в ячейку замера (после - CAPACITY).
+			// Барьер не даёт чтениям замеров выше переместиться после повторного чтения written и вместе
+			// с барьером в Zone::~Zone гарантирует, что частично перезаписанный замер не попадёт в результат
+			std::atomic_thread_fence(memory_order_acquire);
+			const uint64_t after = buffer.written.load(memory_order_acquire);
+			const uint64_t valid = after + 1 > CAPACITY ? after + 1 - CAPACITY : 0;
+
+			if (valid > first) {
+				result.erase(result.begin(), result.begin() + std::min<uint64_t>(valid - first, result.size()));
+			}
+		}
+
+
+		bool dump() {
+			std::error_code error;
+			std::filesystem::create_directories(DEBUG_DIR, error);
+
+			std::ofstream file(TRACE_FILE);
+			file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+			std::lock_guard lock(buffersMutex);
+			vector<EventCopy> events;
+			bool first = true;
+
+			for (const unique_ptr<ThreadBuffer>& buffer : buffers) {
+				if (!buffer->name.empty()) {
+					file << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->id << ",\"args\":{\"name\":";
+					writeString(file, buffer->name.c_str());
+					file << "}}";
+					first = false;
+				}
+
+				copyEvents(*buffer, events);
+
+				for (const EventCopy& event : events) {
+					file << (first ? "" : ",\n") << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id << ",\"name\":";
+					writeString(file, event.name);
+					file << ",\"ts\":";
+					writeMicroseconds(file, event.begin);
+					file << ",\"dur\":";
+					writeMicroseconds(file, event.end - event.begin);
+					file << '}';
+					first = false;
+				}
+			}
+
+			file << "\n]}\n";
+			return file.good();
+		}
+	}
+}
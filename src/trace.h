@@ -0,0 +1,52 @@
+#ifndef HACK_GAME__TRACE_H
+#define HACK_GAME__TRACE_H
+
+#include <cstdint>
+
+#define TRACE_ZONE_VARIABLE_(line) traceZone##line
+#define TRACE_ZONE_VARIABLE(line) TRACE_ZONE_VARIABLE_(line)
+
+/// Замеряет время от этой строки до конца блока. name должен жить до вызова trace::dump
+#define TRACE_ZONE(name) hack_game::trace::Zone TRACE_ZONE_VARIABLE(__LINE__)(name)
+
+namespace hack_game {
+
+	/**
+	 * @brief Запись временной шкалы процессора в формате Chrome trace (открывается в chrome://tracing и Perfetto).
+	 * Каждый поток пишет замеры в свой кольцевой буфер без блокировок, поэтому буфер хранит только
+	 * последние несколько десятков секунд. Буферы живут до конца программы, даже если поток уже завершился.
+	 * Пока запись выключена, замеры ничего не делают
+	 */
+	namespace trace {
+
+		/// @brief Включает запись. Вызывается до запуска остальных потоков
+		void enable() noexcept;
+
+		bool isEnabled() noexcept;
+
+		/// @brief Задаёт имя текущего потока на временной шкале. Ничего не делает, если запись выключена
+		void setThreadName(const char* name);
+
+		/**
+		 * @brief Записывает буферы всех потоков в DEBUG_DIR "trace.json". Можно вызывать из любого потока
+		 * во время записи: замеры, которые потоки перезаписали во время сохранения, отбрасываются
+		 * @return false, если файл не удалось записать
+		 */
+		bool dump();
+
+		/// @brief Замер от создания до уничтожения объекта. Используется через TRACE_ZONE
+		class Zone {
+			const char* name; // nullptr, если запись выключена
+			int64_t begin;
+
+		public:
+			explicit Zone(const char* name) noexcept;
+			~Zone();
+
+			Zone(const Zone&) = delete;
+			Zone& operator=(const Zone&) = delete;
+		};
+	}
+}
+
+#endif
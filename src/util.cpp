@@ -1,14 +1,8 @@
 #include "util.h"
-#include "entity/block.h"
-#include "level/level.h"
 
 namespace hack_game {
-	using std::min;
-	using std::max;
-
 	using glm::vec2;
 	using glm::vec3;
-	using glm::uvec2;
 
 	static_assert(zoom(1, 0, 2, 6, 8) == 7);
 	static_assert(zoom(150, 100, 200, 0, 1) == 0.5f);
@@ -20,6 +14,17 @@ namespace hack_game {
 	static_assert(!isPointInsideSphere(vec3(0), vec3(1), 1.7320507f));
 
 
+	static constexpr bool all_isnan(const vec2& v) {
+		return std::isnan(v.x) && std::isnan(v.y);
+	}
+
+	static_assert(getIntersectPoint(vec2(1, 1), vec2(0, -2), vec2(0, 0), 1) == vec2(1, 0));
+	static_assert(all_isnan(getIntersectPoint(vec2(2, 1), vec2(0, -2), vec2(0, 0), 1)));
+
+	static_assert(getIntersectPoint(vec2(0, 0), vec2(1, 1), vec2(0, 0), 1) == vec2(std::sqrt(0.5f), std::sqrt(0.5f)));
+	static_assert(all_isnan(getIntersectPoint(vec2(1, 1), vec2(2, 2), vec2(0, 0), 1)));
+
+
 	float horizontalAngleBetween(const vec3& pos, const vec3& lookAt) {
 		vec2 dir(
 			lookAt.x - pos.x,
@@ -34,73 +39,13 @@ namespace hack_game {
 	}
 
 
-	static vec2 resolveBlockCollision(const Level& level, const vec2& pos, vec2 offset, const uvec2& mapPos) {
-		if (level.map[mapPos] == nullptr) {
-			return offset;
-		}
+	uint64_t hashFnv1a(const void* data, size_t size, uint64_t hash) noexcept {
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
 
-		const AABB block = level.map[mapPos]->getHitbox();
-		const vec2 newPos = pos + offset;
-		
-		if (offset.x != 0 && block.containsInclusive(vec2(newPos.x, pos.y))) {
-			if (offset.x > 0) offset.x = max(0.0f, offset.x + (block.min.x - newPos.x - EPSILON));
-			else              offset.x = min(0.0f, offset.x + (block.max.x - newPos.x + EPSILON));
+		for (size_t i = 0; i < size; i++) {
+			hash = (hash ^ bytes[i]) * 0x100000001B3;
 		}
 
-		if (offset.y != 0 && block.containsInclusive(vec2(pos.x, newPos.y))) {
-			if (offset.y > 0) offset.y = max(0.0f, offset.y + (block.min.y - newPos.y - EPSILON));
-			else              offset.y = min(0.0f, offset.y + (block.max.y - newPos.y + EPSILON));
-		}
-
-		return offset;
-	}
-
-
-	vec2 resolveBlockCollision(const Level& level, const vec2& pos, vec2 offset) {
-		const vec2 newPos = pos + offset;
-		const uvec2 minPos = level.getMapPos(glm::min(pos, newPos) - EPSILON);
-		const uvec2 maxPos = level.getMapPos(glm::max(pos, newPos) + EPSILON);
-
-		offset = resolveBlockCollision(level, pos, offset, minPos);
-
-		if (minPos.x != maxPos.x) {
-			offset = resolveBlockCollision(level, pos, offset, uvec2(maxPos.x, minPos.y));
-		}
-
-		if (minPos.y != maxPos.y) {
-			offset = resolveBlockCollision(level, pos, offset, uvec2(minPos.x, maxPos.y));
-
-			if (minPos.x != maxPos.x) {
-				offset = resolveBlockCollision(level, pos, offset, maxPos);
-			}
-		}
-
-		return offset;
-	}
-
-
-	int randomBetween(int low, int high) {
-		assert(low <= high);
-		assert(low >= 0);
-		assert(high <= RAND_MAX);
-		return low + rand() % (high - low + 1);
-	}
-
-	float randomBetween(float low, float high) {
-		return low + float(rand()) * (high - low) * (1.0f / RAND_MAX);
-	}
-
-	vec3 randomBetween(const vec3& low, const vec3& high) {
-		return vec3(
-			randomBetween(low.x, high.x),
-			randomBetween(low.y, high.y),
-			randomBetween(low.z, high.z)
-		);
-	}
-
-	int32_t randomInt32() {
-		return  ((rand() >> 3) << 24) |
-				((rand() >> 3) << 12) |
-				(rand() >> 3);
+		return hash;
 	}
 }
\ No newline at end of file
@@ -1,14 +1,15 @@
 #ifndef HACK_GAME__UTIL_H
 #define HACK_GAME__UTIL_H
 
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/gtx/vector_angle.hpp>
 
 namespace hack_game {
 
-	class Level;
-
-
 	/// @brief Вектор нормали угла в 2d. От него сичитается угол
 	constexpr glm::vec2 ANGLE_NORMAL = {0.0f, 1.0f};
 
@@ -50,39 +51,107 @@ namespace hack_game {
 	}
 
 	/**
-	 * @return Угол в 2d от ANGLE_NORMAL до вектора между pos и lookAt.
-	 * Если pos и lookAt находятся в одной точке, то возвращает NaN
+	 * Ищет точку пересечения отрезка и окружности. Если таких две, возвращает любую из них.
+	 * @param[in] pos Первая точка отрезка
+	 * @param[in] offset Смещение от первой точки отрезка до второй
+	 * @param[in] center Центр окружности
+	 * @param[in] radius Радиус окружности
+	 * @return Точку пересечения отрезка и окружности. Если её нет, возвращает `vec2(NaN)`.
+	 *         Точка может быть за пределами отрезка максимум на @ref EPSILON по обоим осям x и y.
 	 */
-	float horizontalAngleBetween(const glm::vec3& pos, const glm::vec3& lookAt);
+	constexpr glm::vec2 getIntersectPoint(const glm::vec2& pos, const glm::vec2& offset, const glm::vec2& center, float radius) {
+		using std::min;
+		using std::max;
 
+		constexpr float NaN = std::numeric_limits<float>::quiet_NaN();
 
-	/**
-	 * @brief Разрешает коллизию точки с блоками на карте
-	 * @param level уровень для получения блока
-	 * @param pos позиция точки на плоскости
-	 * @param offset смещение точки
-	 * @return Новое смещение
-	 */
-	glm::vec2 resolveBlockCollision(const Level& level, const glm::vec2& pos, glm::vec2 offset);
+		const float cx = center.x;
+		const float cy = center.y;
+
+		if (offset.x == 0) {
+			const float A = 1;
+			const float B = -2 * cy;
+			const float C = std::pow(pos.x - cx, 2.0f) + cy*cy - radius*radius;
+
+			const float D = B*B - 4*A*C;
+			if (D < 0) {
+				return glm::vec2(NaN);
+			}
+
+			const float sqrtD = std::sqrt(D);
+
+			const float y1 = (-B + sqrtD) / (2*A);
+			const float y2 = (-B - sqrtD) / (2*A);
+
+			const glm::vec2 newPos = pos + offset;
+
+			if (y1 >= min(pos.y, newPos.y) && y1 <= max(pos.y, newPos.y)) {
+				return glm::vec2(pos.x, y1);
+			}
+
+			if (y2 >= min(pos.y, newPos.y) && y2 <= max(pos.y, newPos.y)) {
+				return glm::vec2(pos.x, y2);
+			}
+
+			return glm::vec2(NaN);
+		}
+
+		const float a = offset.y / offset.x;
+		const float b = pos.y - a * pos.x;
+
+		const float A = a*a + 1;
+		const float B = 2 * (a * (b - cy) - cx);
+		const float C = std::pow(b - cy, 2.0f) + cx*cx - radius*radius;
+
+		const float D = B*B - 4*A*C;
+		if (D < 0) {
+			return glm::vec2(NaN);
+		}
+
+		const float sqrtD = std::sqrt(D);
+
+		const float x1 = (-B + sqrtD) / (2*A);
+		const float x2 = (-B - sqrtD) / (2*A);
+
+		const float y1 = a * x1 + b;
+		const float y2 = a * x2 + b;
+
+		const glm::vec2 newPos = pos + offset;
+		const float minX = min(pos.x, newPos.x) - EPSILON;
+		const float minY = min(pos.y, newPos.y) - EPSILON;
+		const float maxX = max(pos.x, newPos.x) + EPSILON;
+		const float maxY = max(pos.y, newPos.y) + EPSILON;
+
+		if (x1 >= minX && x1 <= maxX &&
+			y1 >= minY && y1 <= maxY) {
+			return glm::vec2(x1, y1);
+		}
+
+		if (x1 != x2 &&
+			x2 >= minX && x2 <= maxX &&
+			y2 >= minY && y2 <= maxY) {
+			return glm::vec2(x2, y2);
+		}
+
+		return glm::vec2(NaN);
+	}
 
 
 	/**
-	 * Генерирует рандомное значение в диапазоне от low до high.
-	 * Обязательные условия: low <= high, low >= 0, high <= RAND_MAX.
-	 * При невыполнении условий ошибка в Debug Mode и UB в Release
-	 * @return Рандомное значение
+	 * @return Угол в 2d от ANGLE_NORMAL до вектора между pos и lookAt.
+	 * Если pos и lookAt находятся в одной точке, то возвращает NaN
 	 */
-	int randomBetween(int low, int high);
+	float horizontalAngleBetween(const glm::vec3& pos, const glm::vec3& lookAt);
+
 
-	/// @brief Генерирует рандомное значение в диапазоне от low до high.
-	float randomBetween(float low, float high);
-	
-	/// @brief Генерирует рандомный вектор в диапазоне от low до high.
-	glm::vec3 randomBetween(const glm::vec3& low, const glm::vec3& high);
+	/// @brief Начальное значение хэша FNV-1a
+	constexpr uint64_t FNV1A_OFFSET_BASIS = 0xCBF29CE484222325;
 
-	/// @brief Генерирует рандомный int32_t с лучшим разпределением, чем у стандартного rand().
-	/// Гарантируется, что все 32 бита заполнены случайно
-	int32_t randomInt32();
+	/**
+	 * @brief Хэширует данные алгоритмом FNV-1a. Чтобы получить хэш нескольких кусков данных,
+	 * передайте в hash результат хэширования предыдущего куска
+	 */
+	uint64_t hashFnv1a(const void* data, size_t size, uint64_t hash = FNV1A_OFFSET_BASIS) noexcept;
 }
 
 #endif
\ No newline at end of file
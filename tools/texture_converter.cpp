@@ -0,0 +1,308 @@
+/**
+ * Переводит изображение в файл .tex (см. texture_file.h): строит все уровни mipmap и выбирает
+ * самый компактный формат, который позволяет содержимое изображения. Запускается при сборке (цель textures).
+ *
+ * Использование: texture_converter <изображение> <файл .tex> [<размер>]
+ * Если указан размер, изображение сначала приводится к квадрату этого размера
+ */
+
+#include "texture_file.h"
+
+#include <cmath>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <SOIL/SOIL.h>
+
+namespace hack_game {
+	using std::vector;
+	using std::string;
+	using texture_file::Format;
+
+	/// Изображение RGBA, построчно
+	struct Image {
+		GLsizei width, height;
+		vector<uint8_t> pixels;
+
+		Image(GLsizei width, GLsizei height):
+				width(width), height(height), pixels(size_t(width) * size_t(height) * 4) {}
+
+		uint8_t* at(GLsizei x, GLsizei y) noexcept {
+			return pixels.data() + (size_t(y) * size_t(width) + size_t(x)) * 4;
+		}
+
+		const uint8_t* at(GLsizei x, GLsizei y) const noexcept {
+			return pixels.data() + (size_t(y) * size_t(width) + size_t(x)) * 4;
+		}
+
+		/// @return Пиксель или прозрачный пиксель, если координаты за пределами изображения
+		const uint8_t* atOrTransparent(int x, int y) const noexcept {
+			static const uint8_t transparent[4] = {};
+			return x < 0 || y < 0 || x >= width || y >= height ? transparent : at(x, y);
+		}
+
+		/// @return Пиксель, координаты которого прижаты к краю изображения
+		const uint8_t* atClamped(int x, int y) const noexcept {
+			return at(std::min(x, width - 1), std::min(y, height - 1));
+		}
+	};
+
+
+	/**
+	 * @brief Приводит изображение к размеру width x height билинейной интерполяцией.
+	 * Центры новых пикселей выбираются так же, как их выбирает OpenGL, а за краем изображение прозрачное,
+	 * как при GL_CLAMP_TO_BORDER, поэтому в шейдере текстура выглядит так же, как исходная
+	 */
+	static Image resample(const Image& image, GLsizei width, GLsizei height) {
+		Image result(width, height);
+
+		const float scaleX = float(image.width) / float(width);
+		const float scaleY = float(image.height) / float(height);
+
+		for (GLsizei y = 0; y < height; y++) {
+			const float sourceY = (float(y) + 0.5f) * scaleY - 0.5f;
+			const int y0 = int(std::floor(sourceY));
+			const float fy = sourceY - float(y0);
+
+			for (GLsizei x = 0; x < width; x++) {
+				const float sourceX = (float(x) + 0.5f) * scaleX - 0.5f;
+				const int x0 = int(std::floor(sourceX));
+				const float fx = sourceX - float(x0);
+
+				const uint8_t* p00 = image.atOrTransparent(x0,     y0);
+				const uint8_t* p10 = image.atOrTransparent(x0 + 1, y0);
+				const uint8_t* p01 = image.atOrTransparent(x0,     y0 + 1);
+				const uint8_t* p11 = image.atOrTransparent(x0 + 1, y0 + 1);
+
+				uint8_t* pixel = result.at(x, y);
+
+				for (int c = 0; c < 4; c++) {
+					const float top    = float(p00[c]) + (float(p10[c]) - float(p00[c])) * fx;
+					const float bottom = float(p01[c]) + (float(p11[c]) - float(p01[c])) * fx;
+					pixel[c] = uint8_t(std::lround(top + (bottom - top) * fy));
+				}
+			}
+		}
+
+		return result;
+	}
+
+
+	/**
+	 * @brief Строит следующий уровень mipmap усреднением квадратов 2x2.
+	 * Цвет усредняется с весом прозрачности, чтобы прозрачные пиксели не затемняли края
+	 */
+	static Image downsample(const Image& image) {
+		Image result(texture_file::getLevelSize(image.width, 1), texture_file::getLevelSize(image.height, 1));
+
+		for (GLsizei y = 0; y < result.height; y++) {
+			for (GLsizei x = 0; x < result.width; x++) {
+				const uint8_t* samples[] = {
+					image.atClamped(2 * x,     2 * y),
+					image.atClamped(2 * x + 1, 2 * y),
+					image.atClamped(2 * x,     2 * y + 1),
+					image.atClamped(2 * x + 1, 2 * y + 1),
+				};
+
+				unsigned alphaSum = 0;
+				unsigned colorSum[3] = {};
+
+				for (const uint8_t* sample : samples) {
+					alphaSum += sample[3];
+
+					for (int c = 0; c < 3; c++) {
+						colorSum[c] += unsigned(sample[c]) * sample[3];
+					}
+				}
+
+				uint8_t* pixel = result.at(x, y);
+
+				for (int c = 0; c < 3; c++) {
+					pixel[c] = alphaSum == 0 ? 0 : uint8_t((colorSum[c] + alphaSum / 2) / alphaSum);
+				}
+
+				pixel[3] = uint8_t((alphaSum + 2) / 4);
+			}
+		}
+
+		return result;
+	}
+
+
+	/// @return Самый компактный формат для содержимого изображения. Серые изображения сжимаются с небольшой потерей точности
+	static Format chooseFormat(const Image& image) {
+		bool gray = true, opaque = true;
+
+		for (size_t i = 0; i < image.pixels.size(); i += 4) {
+			const uint8_t* pixel = image.pixels.data() + i;
+			gray = gray && pixel[0] == pixel[1] && pixel[0] == pixel[2];
+			opaque = opaque && pixel[3] == 255;
+		}
+
+		if (gray) {
+			return opaque ? Format::RGTC1 : Format::RGTC2;
+		}
+
+		return opaque ? Format::RGB8 : Format::RGBA8;
+	}
+
+
+	/**
+	 * @brief Сжимает блок 4x4 одного канала в формат RGTC (BC4): две опорные точки и 3-битный индекс на пиксель.
+	 * Опорные точки - минимум и максимум блока, между ними равномерно лежат ещё 6 значений
+	 */
+	static void encodeRgtcBlock(const uint8_t values[16], uint8_t* result) {
+		uint8_t low = 255, high = 0;
+
+		for (int i = 0; i < 16; i++) {
+			low = std::min(low, values[i]);
+			high = std::max(high, values[i]);
+		}
+
+		// При red0 > red1 индексы 0 и 1 - опорные точки, а 2..7 - значения между ними от red0 к red1
+		int palette[8] = { high, low };
+
+		for (int i = 2; i < 8; i++) {
+			palette[i] = ((8 - i) * high + (i - 1) * low) / 7;
+		}
+
+		uint64_t indices = 0;
+
+		if (high != low) {
+			for (int i = 0; i < 16; i++) {
+				int best = 0;
+
+				for (int j = 1; j < 8; j++) {
+					if (std::abs(palette[j] - values[i]) < std::abs(palette[best] - values[i])) {
+						best = j;
+					}
+				}
+
+				indices |= uint64_t(best) << (3 * i);
+			}
+		}
+
+		result[0] = high;
+		result[1] = low;
+
+		for (int i = 0; i < 6; i++) {
+			result[2 + i] = uint8_t(indices >> (8 * i));
+		}
+	}
+
+	/// @brief Сжимает каналы channels изображения в RGTC, по 8 байт на канал в каждом блоке
+	static void encodeRgtc(const Image& image, std::initializer_list<int> channels, vector<uint8_t>& result) {
+		for (GLsizei blockY = 0; blockY < image.height; blockY += 4) {
+			for (GLsizei blockX = 0; blockX < image.width; blockX += 4) {
+				for (int channel : channels) {
+					uint8_t values[16];
+
+					for (int i = 0; i < 16; i++) {
+						values[i] = image.atClamped(blockX + i % 4, blockY + i / 4)[channel];
+					}
+
+					result.resize(result.size() + 8);
+					encodeRgtcBlock(values, result.data() + result.size() - 8);
+				}
+			}
+		}
+	}
+
+	/// @brief Добавляет уровень в формате format в конец result
+	static void encode(const Image& image, Format format, vector<uint8_t>& result) {
+		switch (format) {
+			case Format::RGBA8:
+				result.insert(result.end(), image.pixels.begin(), image.pixels.end());
+				break;
+
+			case Format::RGB8:
+				for (size_t i = 0; i < image.pixels.size(); i += 4) {
+					result.insert(result.end(), image.pixels.begin() + i, image.pixels.begin() + i + 3);
+				}
+				break;
+
+			case Format::RGTC1:
+				encodeRgtc(image, {0}, result);
+				break;
+
+			case Format::RGTC2:
+				encodeRgtc(image, {0, 3}, result);
+				break;
+		}
+	}
+
+
+	static const char* getFormatName(Format format) {
+		switch (format) {
+			case Format::RGBA8: return "RGBA8";
+			case Format::RGB8:  return "RGB8";
+			case Format::RGTC1: return "RGTC1";
+			case Format::RGTC2: return "RGTC2";
+		}
+
+		return "?";
+	}
+
+
+	static int convert(const char* sourcePath, const char* resultPath, GLsizei size) {
+		int width, height;
+		uint8_t* data = SOIL_load_image(sourcePath, &width, &height, nullptr, SOIL_LOAD_RGBA);
+
+		if (data == nullptr) {
+			std::cerr << "Cannot open file '" << sourcePath << "'" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		Image image(width, height);
+		std::memcpy(image.pixels.data(), data, image.pixels.size());
+		SOIL_free_image_data(data);
+
+		if (size > 0 && (width != size || height != size)) {
+			image = resample(image, size, size);
+		}
+
+		const Format format = chooseFormat(image);
+		const GLsizei levelWidth = image.width, levelHeight = image.height;
+
+		vector<uint8_t> levels;
+		GLint levelCount = 1;
+		encode(image, format, levels);
+
+		while (image.width > 1 || image.height > 1) {
+			image = downsample(image);
+			encode(image, format, levels);
+			levelCount += 1;
+		}
+
+		const texture_file::TextureData result {
+			.format = format,
+			.width = levelWidth,
+			.height = levelHeight,
+			.levelCount = levelCount,
+			.levels = levels.data(),
+		};
+
+		if (!texture_file::save(resultPath, result)) {
+			std::cerr << "Cannot write file '" << resultPath << "'" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		std::cout << sourcePath << ": " << levelWidth << "x" << levelHeight << " " << getFormatName(format) << ", "
+		          << levelCount << " levels, " << size_t(width) * size_t(height) * 4 << " -> " << levels.size() << " bytes" << std::endl;
+
+		return EXIT_SUCCESS;
+	}
+}
+
+
+int main(int argc, const char* argv[]) {
+	if (argc != 3 && argc != 4) {
+		std::cerr << "Usage: " << argv[0] << " <image> <result.tex> [<size>]" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return hack_game::convert(argv[1], argv[2], argc == 4 ? std::atoi(argv[3]) : 0);
+}